@@ -0,0 +1,384 @@
+// linearobjects_bench: times the library's core operations over a sweep of sizes and thread counts and
+// reports ns/op, GFLOP/s and bytes allocated per operation as JSON. Given a baseline (the JSON of an
+// earlier run), every case is compared against it and slowdowns beyond the tolerance are flagged.
+//
+// Usage: linearobjects_bench [options]
+//   --sizes 64,256,1024      Matrix sides n (vector cases use n * n elements)
+//   --threads 1,2,4          Thread pool sizes, 0 = hardware concurrency
+//   --filter multiply        Only cases whose name contains the text
+//   --min-time 0.2           Seconds each measurement should run for
+//   --repetitions 3          Measurements per case; the fastest one is reported
+//   --output results.json    Write the JSON there instead of stdout
+//   --baseline old.json      Compare against an earlier run
+//   --tolerance 0.10         Allowed slowdown against the baseline (fraction)
+// Exit code: 0 success, 1 regression against the baseline, 2 bad arguments or unreadable files.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "MemoryResource.hpp"
+#include "SquareMatrix.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+
+#ifndef LINEAROBJECTS_VERSION
+#define LINEAROBJECTS_VERSION "unknown"
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Operation = std::function<void()>;
+
+struct Options {
+    std::vector<std::size_t> sizes{64, 256, 1024};
+    std::vector<std::size_t> threads{1};
+    std::string filter{};
+    double minTime{0.2};
+    std::size_t repetitions{3};
+    std::string output{};
+    std::string baseline{};
+    double tolerance{0.10};
+};
+
+struct BenchCase {
+    const char* name;
+    double (*flops)(std::size_t n);            // Floating point operations per call, 0 when not meaningful
+    Operation (*prepare)(std::size_t n);       // Builds the operands; the returned call is what gets timed
+};
+
+struct Result {
+    std::string name{};
+    std::size_t size{};
+    std::size_t threads{};
+    std::size_t iterations{};
+    double nsPerOp{};
+    double gflops{};
+    double bytesPerOp{};
+    double allocationsPerOp{};
+    double baselineNsPerOp{};          // 0 when the baseline has no matching case
+    bool regression{};
+};
+
+volatile double sink = 0.0;        // Keeps scalar results alive
+
+Matrix randomMatrix(std::size_t rows, std::size_t columns, unsigned seed) {
+    // Scaled so that products and powers of random matrices keep their magnitude (no overflow, no subnormals)
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    double scale = std::sqrt(3.0 / static_cast<double>(columns));
+    Matrix result(rows, columns);
+    for(std::size_t i = 0; i < rows; i++)
+        for(std::size_t j = 0; j < columns; j++)
+            result[i][j] = distribution(engine) * scale;
+    return result;
+}
+
+Vector randomVector(std::size_t size, unsigned seed) {
+    std::mt19937 engine(seed);
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+    Vector result(size);
+    for(std::size_t i = 0; i < size; i++)
+        result[i] = distribution(engine);
+    return result;
+}
+
+double cube(std::size_t n) {
+    auto value = static_cast<double>(n);
+    return value * value * value;
+}
+
+const std::vector<BenchCase>& benchCases() {
+    static const std::vector<BenchCase> cases = {
+        {"multiply", [](std::size_t n) { return 2.0 * cube(n); }, [](std::size_t n) -> Operation {
+            return [a = randomMatrix(n, n, 1), b = randomMatrix(n, n, 2)] { Matrix c = a * b; sink = sink + c.element(0, 0); };
+        }},
+        {"transposed_multiply", [](std::size_t n) { return 2.0 * cube(n); }, [](std::size_t n) -> Operation {
+            // A^T * B through a transposed view, no copy of A
+            return [a = randomMatrix(n, n, 1), b = randomMatrix(n, n, 2)] {
+                Matrix c = a.transposed() * b;
+                sink = sink + c.element(0, 0);
+            };
+        }},
+        {"square_multiply", [](std::size_t n) { return 2.0 * cube(n); }, [](std::size_t n) -> Operation {
+            // May take the Strassen path (see Strassen.hpp); GFLOP/s are nominal 2n^3 rates
+            return [a = SquareMatrix(randomMatrix(n, n, 1)), b = SquareMatrix(randomMatrix(n, n, 2))] {
+                SquareMatrix c = a * b;
+                sink = sink + c.element(0, 0);
+            };
+        }},
+        {"power_8", [](std::size_t n) { return 3.0 * 2.0 * cube(n); }, [](std::size_t n) -> Operation {
+            return [a = SquareMatrix(randomMatrix(n, n, 1))] { SquareMatrix c = a ^ 8; sink = sink + c.element(0, 0); };
+        }},
+        {"transpose", [](std::size_t) { return 0.0; }, [](std::size_t n) -> Operation {
+            // n x 2n, so the shape changes on every call
+            return [a = randomMatrix(n, 2 * n, 1)]() mutable { a.transpose(); };
+        }},
+        {"dot", [](std::size_t n) { return 2.0 * static_cast<double>(n * n); }, [](std::size_t n) -> Operation {
+            return [x = randomVector(n * n, 1), y = randomVector(n * n, 2)] { sink = sink + x.dot(y); };
+        }},
+        {"dot_parallel", [](std::size_t n) { return 2.0 * static_cast<double>(n * n); }, [](std::size_t n) -> Operation {
+            return [x = randomVector(n * n, 1), y = randomVector(n * n, 2)] {
+                sink = sink + x.dot(ExecutionPolicy::ParallelDeterministic, y);
+            };
+        }},
+        {"add", [](std::size_t n) { return static_cast<double>(n * n); }, [](std::size_t n) -> Operation {
+            return [a = randomMatrix(n, n, 1), b = randomMatrix(n, n, 2), c = Matrix(n, n)]() mutable {
+                c = a + b;
+                sink = sink + c.element(0, 0);
+            };
+        }},
+        {"add_parallel", [](std::size_t n) { return static_cast<double>(n * n); }, [](std::size_t n) -> Operation {
+            return [a = randomMatrix(n, n, 1), b = randomMatrix(n, n, 2), c = Matrix(n, n)]() mutable {
+                c.assign(ExecutionPolicy::Parallel, a + b);
+                sink = sink + c.element(0, 0);
+            };
+        }},
+        {"sub_matrix", [](std::size_t) { return 0.0; }, [](std::size_t n) -> Operation {
+            // The middle quarter
+            return [a = randomMatrix(n, n, 1), n] {
+                Matrix c = a.getSubMatrix(n / 4, n / 4 + n / 2 - 1, n / 4, n / 4 + n / 2 - 1);
+                sink = sink + c.element(0, 0);
+            };
+        }},
+        {"construct", [](std::size_t) { return 0.0; }, [](std::size_t n) -> Operation {
+            return [n] { Matrix c(n, n); sink = sink + c.element(0, 0); };
+        }},
+        {"copy", [](std::size_t) { return 0.0; }, [](std::size_t n) -> Operation {
+            return [a = randomMatrix(n, n, 1)] { Matrix c(a); sink = sink + c.element(0, 0); };
+        }},
+    };
+    return cases;
+}
+
+std::vector<std::size_t> parseList(const std::string& text) {
+    std::vector<std::size_t> values;
+    std::stringstream stream(text);
+    std::string item;
+    while(std::getline(stream, item, ','))
+        values.push_back(std::stoul(item));
+    if(values.empty())
+        throw std::invalid_argument("Empty list: " + text);
+    return values;
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options options;
+    for(int i = 1; i < argc; i++) {
+        std::string flag = argv[i];
+        if(i + 1 >= argc)
+            throw std::invalid_argument("Missing value for " + flag);
+        std::string value = argv[++i];
+        if(flag == "--sizes")
+            options.sizes = parseList(value);
+        else if(flag == "--threads")
+            options.threads = parseList(value);
+        else if(flag == "--filter")
+            options.filter = value;
+        else if(flag == "--min-time")
+            options.minTime = std::stod(value);
+        else if(flag == "--repetitions")
+            options.repetitions = std::max<std::size_t>(1, std::stoul(value));
+        else if(flag == "--output")
+            options.output = value;
+        else if(flag == "--baseline")
+            options.baseline = value;
+        else if(flag == "--tolerance")
+            options.tolerance = std::stod(value);
+        else
+            throw std::invalid_argument("Unknown option: " + flag);
+    }
+    if(std::find(options.sizes.begin(), options.sizes.end(), 0) != options.sizes.end())
+        throw std::invalid_argument("Condition didn't match (size > 0)");
+    return options;
+}
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Doubles the iteration count until one batch runs for minTime, then keeps the fastest of the
+// repetitions. Allocations are counted over the measured batches.
+Result measure(const BenchCase& benchCase, std::size_t n, const Options& options) {
+    Operation operation = benchCase.prepare(n);
+    operation();    // Warm-up: first touch of the operands, thread-local workspaces
+
+    std::size_t iterations = 1;
+    while(true) {
+        Clock::time_point start = Clock::now();
+        for(std::size_t i = 0; i < iterations; i++)
+            operation();
+        if(secondsSince(start) >= options.minTime / 2 || iterations >= (std::size_t(1) << 30))
+            break;
+        iterations *= 2;
+    }
+
+    double best = 0.0;
+    resetAllocationStats();
+    for(std::size_t repetition = 0; repetition < options.repetitions; repetition++) {
+        Clock::time_point start = Clock::now();
+        for(std::size_t i = 0; i < iterations; i++)
+            operation();
+        double elapsed = secondsSince(start);
+        if(repetition == 0 || elapsed < best)
+            best = elapsed;
+    }
+    AllocationStats stats = allocationStats();
+
+    Result result;
+    result.name = benchCase.name;
+    result.size = n;
+    result.threads = ThreadPool::instance().getThreadCount();
+    result.iterations = iterations;
+    result.nsPerOp = best * 1e9 / static_cast<double>(iterations);
+    result.gflops = benchCase.flops(n) / result.nsPerOp;
+    auto calls = static_cast<double>(iterations * options.repetitions);
+    result.bytesPerOp = static_cast<double>(stats.bytesAllocated) / calls;
+    result.allocationsPerOp = static_cast<double>(stats.allocations) / calls;
+    return result;
+}
+
+// Baseline files are read back with a reader for exactly what writeJson() produces: flat objects of
+// string and number fields inside the "results" array.
+std::map<std::tuple<std::string, std::size_t, std::size_t>, double> readBaseline(const std::string& path) {
+    std::ifstream file(path);
+    if(!file)
+        throw std::runtime_error("Cannot open file: " + path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    std::map<std::tuple<std::string, std::size_t, std::size_t>, double> baseline;
+    std::size_t position = text.find("\"results\"");
+    if(position == std::string::npos)
+        throw std::runtime_error("Not a benchmark result file: " + path);
+    while((position = text.find('{', position)) != std::string::npos) {
+        std::size_t end = text.find('}', position);
+        if(end == std::string::npos)
+            break;
+        std::map<std::string, std::string> fields;
+        std::string object = text.substr(position + 1, end - position - 1);
+        std::size_t cursor = 0;
+        while((cursor = object.find('"', cursor)) != std::string::npos) {
+            std::size_t keyEnd = object.find('"', cursor + 1);
+            std::size_t colon = object.find(':', keyEnd);
+            if(keyEnd == std::string::npos || colon == std::string::npos)
+                break;
+            std::string key = object.substr(cursor + 1, keyEnd - cursor - 1);
+            std::size_t valueStart = object.find_first_not_of(" \t\r\n", colon + 1);
+            std::size_t valueEnd;
+            if(valueStart != std::string::npos && object[valueStart] == '"') {
+                valueEnd = object.find('"', valueStart + 1);
+                fields[key] = object.substr(valueStart + 1, valueEnd - valueStart - 1);
+                valueEnd++;
+            } else {
+                valueEnd = std::min(object.find(',', colon), object.size());
+                fields[key] = object.substr(colon + 1, valueEnd - colon - 1);
+            }
+            cursor = valueEnd;
+        }
+        if(fields.count("name") && fields.count("size") && fields.count("threads") && fields.count("ns_per_op"))
+            baseline[{fields["name"], std::stoul(fields["size"]), std::stoul(fields["threads"])}] = std::stod(fields["ns_per_op"]);
+        position = end + 1;
+    }
+    return baseline;
+}
+
+void writeJson(std::ostream& os, const std::vector<Result>& results, const Options& options) {
+    os << std::setprecision(6);
+    os << "{\n";
+    os << "  \"library\": \"LinearObjects " << LINEAROBJECTS_VERSION << "\",\n";
+    os << "  \"min_time\": " << options.minTime << ",\n";
+    os << "  \"repetitions\": " << options.repetitions << ",\n";
+    os << "  \"results\": [";
+    for(std::size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        os << (i ? ",\n" : "\n") << "    {\"name\": \"" << result.name << "\", \"size\": " << result.size
+           << ", \"threads\": " << result.threads << ", \"iterations\": " << result.iterations
+           << ", \"ns_per_op\": " << result.nsPerOp << ", \"gflops\": " << result.gflops
+           << ", \"bytes_per_op\": " << result.bytesPerOp << ", \"allocations_per_op\": " << result.allocationsPerOp;
+        if(result.baselineNsPerOp > 0.0)
+            os << ", \"baseline_ns_per_op\": " << result.baselineNsPerOp
+               << ", \"ratio\": " << result.nsPerOp / result.baselineNsPerOp
+               << ", \"regression\": " << (result.regression ? "true" : "false");
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    std::map<std::tuple<std::string, std::size_t, std::size_t>, double> baseline;
+    try {
+        options = parseOptions(argc, argv);
+        if(!options.baseline.empty())
+            baseline = readBaseline(options.baseline);
+    } catch(const std::exception& error) {
+        std::cerr << "linearobjects_bench: " << error.what() << "\n";
+        return 2;
+    }
+
+    ThreadPool& pool = ThreadPool::instance();
+    std::size_t initialThreads = pool.getThreadCount();
+    std::vector<Result> results;
+    std::size_t regressions = 0;
+    for(std::size_t threads : options.threads) {
+        pool.setThreadCount(threads);
+        for(const BenchCase& benchCase : benchCases()) {
+            if(std::string(benchCase.name).find(options.filter) == std::string::npos)
+                continue;
+            for(std::size_t n : options.sizes) {
+                Result result = measure(benchCase, n, options);
+                auto match = baseline.find({result.name, result.size, result.threads});
+                if(match != baseline.end() && match->second > 0.0) {
+                    result.baselineNsPerOp = match->second;
+                    result.regression = result.nsPerOp > match->second * (1.0 + options.tolerance);
+                    regressions += result.regression;
+                }
+                // Progress and verdicts go to stderr so that stdout stays valid JSON
+                std::cerr << std::left << std::setw(16) << result.name << " n=" << std::setw(6) << n
+                          << " threads=" << std::setw(3) << result.threads << std::right << std::fixed
+                          << std::setprecision(1) << std::setw(14) << result.nsPerOp << " ns/op"
+                          << std::setprecision(2) << std::setw(9) << result.gflops << " GFLOP/s";
+                if(result.baselineNsPerOp > 0.0)
+                    std::cerr << "  x" << result.nsPerOp / result.baselineNsPerOp
+                              << (result.regression ? "  REGRESSION" : "");
+                std::cerr << std::defaultfloat << "\n";
+                results.push_back(std::move(result));
+            }
+        }
+    }
+    pool.setThreadCount(initialThreads);
+
+    if(options.output.empty()) {
+        writeJson(std::cout, results, options);
+    } else {
+        std::ofstream file(options.output);
+        if(!file) {
+            std::cerr << "linearobjects_bench: Cannot open file for writing: " << options.output << "\n";
+            return 2;
+        }
+        writeJson(file, results, options);
+    }
+    if(regressions) {
+        std::cerr << regressions << " regression(s) beyond " << options.tolerance * 100 << "% of the baseline\n";
+        return 1;
+    }
+    return 0;
+}
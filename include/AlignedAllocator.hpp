@@ -0,0 +1,72 @@
+#ifndef ALIGNEDALLOCATOR_HPP
+#define ALIGNEDALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "MemoryResource.hpp"
+
+// Allocator handing out buffers aligned to a cache line, so rows and SIMD loads start on a boundary.
+// Memory comes from a std::pmr::memory_resource (see MemoryResource.hpp): by default the current one of
+// the constructing thread. Like std::pmr::polymorphic_allocator, the resource never propagates on
+// assignment or swap, and a copied container takes the current resource of the copying thread.
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+private:
+    std::pmr::memory_resource* resource;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    // Constructors
+    AlignedAllocator() noexcept : resource(currentMemoryResource()) {}
+    AlignedAllocator(std::pmr::memory_resource* memoryResource) noexcept : resource(memoryResource) {}
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>& allocator) noexcept : resource(allocator.getResource()) {}
+
+    // Methods
+    [[nodiscard]] T* allocate(std::size_t count) {
+        if(count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_array_new_length();
+        T* pointer = static_cast<T*>(resource->allocate(count * sizeof(T), std::max(Alignment, alignof(T))));
+        recordAllocation(count * sizeof(T));    // Only allocations that succeeded
+        return pointer;
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept {
+        recordDeallocation();
+        resource->deallocate(pointer, count * sizeof(T), std::max(Alignment, alignof(T)));
+    }
+
+    [[nodiscard]] AlignedAllocator select_on_container_copy_construction() const noexcept {
+        return AlignedAllocator();
+    }
+
+    // Getters
+    [[nodiscard]] std::pmr::memory_resource* getResource() const noexcept { return resource; }
+
+    // Friend Operators
+    friend bool operator==(const AlignedAllocator& lhs, const AlignedAllocator& rhs) noexcept {
+        return lhs.resource == rhs.resource || lhs.resource->is_equal(*rhs.resource);
+    }
+    friend bool operator!=(const AlignedAllocator& lhs, const AlignedAllocator& rhs) noexcept { return !(lhs == rhs); }
+};
+
+template<typename T>
+using BasicAlignedBuffer = std::vector<T, AlignedAllocator<T>>;
+using AlignedBuffer = BasicAlignedBuffer<double>;
+
+#endif //ALIGNEDALLOCATOR_HPP
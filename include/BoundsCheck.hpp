@@ -0,0 +1,35 @@
+#ifndef BOUNDSCHECK_HPP
+#define BOUNDSCHECK_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+// Bounds-checking policy of operator[] on Vector, Matrix (row index), the views and the fixed-size types.
+// With LINEAROBJECTS_CHECKED_ACCESS set to 1 every index is checked and a bad one throws
+// std::invalid_argument("Index out of bound"); with 0 nothing is checked, so loops over elements compile
+// to plain loads and stores the optimizer can vectorize. The CMake option LINEAROBJECTS_CHECKED_ACCESS
+// (AUTO, ON, OFF) defines it for the library and everything linking it, AUTO checking in Debug builds
+// only; without CMake it follows NDEBUG. Per call, at() always checks, while element(), data(),
+// begin() / end() and Span (see Span.hpp) never do.
+#ifndef LINEAROBJECTS_CHECKED_ACCESS
+#ifdef NDEBUG
+#define LINEAROBJECTS_CHECKED_ACCESS 0
+#else
+#define LINEAROBJECTS_CHECKED_ACCESS 1
+#endif
+#endif
+
+constexpr bool CHECKED_ACCESS = LINEAROBJECTS_CHECKED_ACCESS != 0;
+
+constexpr void checkIndex(std::size_t idx, std::size_t bound) {
+    if(idx >= bound)
+        throw std::invalid_argument("Index out of bound");
+}
+
+// Checks only under the checked policy
+constexpr void checkIndexByPolicy(std::size_t idx, std::size_t bound) {
+    if constexpr(CHECKED_ACCESS)
+        checkIndex(idx, bound);
+}
+
+#endif //BOUNDSCHECK_HPP
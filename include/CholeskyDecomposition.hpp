@@ -0,0 +1,40 @@
+#ifndef CHOLESKYDECOMPOSITION_HPP
+#define CHOLESKYDECOMPOSITION_HPP
+
+#include <cstddef>
+
+#include "SymmetricMatrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// A = L L^T of one fixed symmetric positive definite matrix, L lower triangular with a positive diagonal.
+// L is kept in the same tiled half storage as SymmetricMatrix, so factoring never needs the full n x n.
+// The factorization is tiled and right-looking: after each diagonal tile is factored, the tiles below it
+// and the trailing tiles are updated independently of one another, on the thread pool, through the
+// multiply kernel (Gemm.hpp). Every tile is computed in the same order whatever the thread count.
+// About half the work of LUDecomposition, with no pivoting; factor once, then solve() as often as needed.
+// Throws if the matrix is not positive definite (a diagonal element of L would be sqrt of a value <= 0).
+class CholeskyDecomposition {
+private:
+    SymmetricMatrix factor;   // L in the lower triangle, zeros above it in the diagonal tiles
+
+    void factorize();
+
+public:
+    // Constructors
+    explicit CholeskyDecomposition(const SymmetricMatrix& matrix);
+
+    // Methods
+    [[nodiscard]] double logDeterminant() const;               // log(det A) = 2 * sum of log(L_ii)
+    [[nodiscard]] Vector solve(ConstVectorView rhs) const;     // x with A x = rhs
+    [[nodiscard]] Matrix solve(ConstMatrixView rhs) const;     // X with A X = rhs, one column per system
+    [[nodiscard]] SquareMatrix lower() const;                  // L
+
+    // Getters
+    [[nodiscard]] std::size_t getDimension() const;
+
+    // Destructor
+    ~CholeskyDecomposition() = default;
+};
+
+#endif //CHOLESKYDECOMPOSITION_HPP
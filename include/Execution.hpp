@@ -0,0 +1,70 @@
+#ifndef EXECUTION_HPP
+#define EXECUTION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+// How the bulk operations that take one run: construction from and assign() of lazy expressions (so
+// C.assign(ExecutionPolicy::Parallel, A + B) or A.assign(policy, 2.0 * A)), dot(), magnitude(),
+// setColumn() and setSubMatrix(). The overloads without a policy are Sequential.
+// Element-wise results are the same under every policy. Reductions are not: Sequential sums in one pass,
+// Parallel sums one chunk per task (so the last bits depend on the thread count), ParallelDeterministic
+// sums fixed EXECUTION_CHUNK-element chunks combined in order (the same bits for any thread count).
+enum class ExecutionPolicy {
+    Sequential,
+    Parallel,
+    ParallelDeterministic
+};
+
+// Elements per task: 256 KB of doubles, about a core's share of the L2 cache.
+constexpr std::size_t EXECUTION_CHUNK = 32768;
+constexpr std::size_t EXECUTION_TASKS_PER_THREAD = 4;
+
+// Rows of columnCount elements that make up one chunk, for row by row operations on matrices.
+inline std::size_t chunkRows(std::size_t columnCount) {
+    return std::max<std::size_t>(1, EXECUTION_CHUNK / std::max<std::size_t>(1, columnCount));
+}
+
+// Calls body(begin, end) for consecutive chunkSize-element ranges of [0, count), on the thread pool
+// unless the policy is Sequential, there is a single chunk or a single thread.
+template<typename Body>
+void forEachChunk(ExecutionPolicy policy, std::size_t count, std::size_t chunkSize, const Body& body) {
+    std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    auto runChunk = [&](std::size_t chunk) {
+        body(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+    };
+    if(policy == ExecutionPolicy::Sequential || chunkCount <= 1 || ThreadPool::instance().getThreadCount() == 1) {
+        for(std::size_t chunk = 0; chunk < chunkCount; chunk++)
+            runChunk(chunk);
+        return;
+    }
+    ThreadPool::instance().parallelFor(chunkCount, runChunk);
+}
+
+// Sum of body(begin, end) over ranges covering [0, count), combined in range order (see ExecutionPolicy).
+template<typename Sum, typename Body>
+Sum reduceChunks(ExecutionPolicy policy, std::size_t count, const Body& body) {
+    if(policy == ExecutionPolicy::Sequential)
+        return body(std::size_t{0}, count);
+
+    std::size_t chunkSize = EXECUTION_CHUNK;
+    if(policy == ExecutionPolicy::Parallel) {
+        std::size_t taskCount = ThreadPool::instance().getThreadCount() * EXECUTION_TASKS_PER_THREAD;
+        chunkSize = std::max(chunkSize, (count + taskCount - 1) / taskCount);
+    }
+    std::size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+    std::vector<Sum> partials(chunkCount);
+    forEachChunk(policy, count, chunkSize, [&](std::size_t begin, std::size_t end) {
+        partials[begin / chunkSize] = body(begin, end);
+    });
+
+    Sum sum = 0;
+    for(Sum partial: partials)
+        sum += partial;
+    return sum;
+}
+
+#endif //EXECUTION_HPP
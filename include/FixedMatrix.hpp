@@ -0,0 +1,214 @@
+#ifndef FIXEDMATRIX_HPP
+#define FIXEDMATRIX_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "FixedVector.hpp"
+#include "Matrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Fixed-size counterpart of Matrix / SquareMatrix (see FixedVector.hpp): R x C elements stored inline,
+// row-major, shapes checked at compile time, loops unrolled, everything but printing constexpr.
+// Square-only operations (identity(), operator^) fail to compile for non-square shapes.
+// Converts implicitly to a (Const)MatrixView, so it can be passed to operator* and gemm() next to
+// dynamic matrices, and explicitly to the dynamic types: Matrix(fixedMatrix), SquareMatrix(fixedMatrix).
+template<std::size_t R, std::size_t C>
+class FixedMatrix {
+    static_assert(R > 0 && C > 0, "Condition didn't match (rowCount, columnCount > 0)");
+
+private:
+    double elements[R * C]{};
+
+    template<typename Generator, std::size_t... I>
+    static constexpr FixedMatrix generate(const Generator& generator, std::index_sequence<I...>) {
+        return FixedMatrix(generator(I / C, I % C)...);
+    }
+
+    // FixedMatrix whose element (i, j) is generator(i, j)
+    template<typename Generator>
+    static constexpr FixedMatrix generate(const Generator& generator) {
+        return generate(generator, std::make_index_sequence<R * C>());
+    }
+
+    // Row i of lhs times column k of rhs
+    template<typename Rhs, std::size_t... J>
+    static constexpr double dot(const FixedMatrix& lhs, std::size_t i, const Rhs& rhs, std::size_t k,
+                                std::index_sequence<J...>) {
+        return ((lhs.elements[i * C + J] * rhs.element(J, k)) + ...);
+    }
+
+    template<std::size_t... J>
+    static constexpr double dot(const FixedMatrix& lhs, std::size_t i, const FixedVector<C>& rhs,
+                                std::index_sequence<J...>) {
+        return ((lhs.elements[i * C + J] * rhs.element(J)) + ...);
+    }
+
+    template<std::size_t... I>
+    constexpr FixedVector<R> multiply(const FixedVector<C>& vec, std::index_sequence<I...>) const {
+        return FixedVector<R>(dot(*this, I, vec, std::make_index_sequence<C>())...);
+    }
+
+    template<std::size_t K>
+    constexpr FixedMatrix<R, K> multiply(const FixedMatrix<C, K>& rhs) const {
+        return FixedMatrix<R, K>::generate([&](std::size_t i, std::size_t k) {
+            return dot(*this, i, rhs, k, std::make_index_sequence<C>());
+        });
+    }
+
+public:
+    static constexpr std::size_t rowCount = R;
+    static constexpr std::size_t columnCount = C;
+
+    // Constructors
+    constexpr FixedMatrix() = default;    // Zero matrix
+    template<typename... Elements, typename = std::enable_if_t<
+            sizeof...(Elements) == R * C && std::conjunction_v<std::is_arithmetic<Elements>...>>>
+    constexpr FixedMatrix(Elements... values) : elements{static_cast<double>(values)...} {}   // Row-major
+    constexpr FixedMatrix(std::initializer_list<std::initializer_list<double>> matrixRows) {
+        if(matrixRows.size() != R)
+            throw std::invalid_argument("Matrix should contain " + std::to_string(R) + " Rows");
+        std::size_t i = 0;
+        for(auto row: matrixRows) {
+            if(row.size() != C)
+                throw std::invalid_argument("Every row should contain " + std::to_string(C) + " Elements");
+            for(double element: row)
+                elements[i++] = element;
+        }
+    }
+    explicit FixedMatrix(ConstMatrixView view) {
+        if(view.getDimension().rowCount != R || view.getDimension().columnCount != C)
+            throw std::invalid_argument("Matrix should be " + std::to_string(R) + "x" + std::to_string(C));
+        for(std::size_t i = 0; i < R; i++)
+            for(std::size_t j = 0; j < C; j++)
+                elements[i * C + j] = view.element(i, j);
+    }
+
+    // Compound Assignment
+    constexpr FixedMatrix& operator+=(const FixedMatrix& rhs) { return *this = *this + rhs; }
+    constexpr FixedMatrix& operator-=(const FixedMatrix& rhs) { return *this = *this - rhs; }
+    constexpr FixedMatrix& operator*=(double coeff) { return *this = *this * coeff; }
+
+    // Methods
+    [[nodiscard]] std::string toString() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+    [[nodiscard]] static constexpr FixedMatrix identity() {
+        static_assert(R == C, "This is not Square Matrix!");
+        return generate([](std::size_t i, std::size_t j) { return i == j ? 1.0 : 0.0; });
+    }
+    [[nodiscard]] constexpr FixedMatrix<C, R> transposed() const {   // The shape is part of the type, so never in place
+        FixedMatrix<C, R> result;
+        for(std::size_t i = 0; i < R; i++)
+            for(std::size_t j = 0; j < C; j++)
+                result[j][i] = elements[i * C + j];
+        return result;
+    }
+
+    // Getters
+    [[nodiscard]] constexpr FixedVector<C> getRow(std::size_t idx) const {
+        if(idx >= R)
+            throw std::invalid_argument("Index out of bound");
+        FixedVector<C> row;
+        for(std::size_t j = 0; j < C; j++)
+            row[j] = elements[idx * C + j];
+        return row;
+    }
+    [[nodiscard]] constexpr FixedVector<R> getColumn(std::size_t idx) const {
+        if(idx >= C)
+            throw std::invalid_argument("Index out of bound");
+        FixedVector<R> column;
+        for(std::size_t i = 0; i < R; i++)
+            column[i] = elements[i * C + idx];
+        return column;
+    }
+    [[nodiscard]] static constexpr MatrixSize getDimension() {
+        MatrixSize size{};
+        size.rowCount = R;
+        size.columnCount = C;
+        return size;
+    }
+    [[nodiscard]] constexpr double element(std::size_t i, std::size_t j) const { return elements[i * C + j]; }   // Unchecked
+
+    // Friend Operators
+    friend constexpr FixedMatrix operator+(const FixedMatrix& lhs, const FixedMatrix& rhs) {
+        return generate([&](std::size_t i, std::size_t j) { return lhs.element(i, j) + rhs.element(i, j); });
+    }
+
+    friend constexpr FixedMatrix operator-(const FixedMatrix& lhs, const FixedMatrix& rhs) {
+        return generate([&](std::size_t i, std::size_t j) { return lhs.element(i, j) - rhs.element(i, j); });
+    }
+
+    friend constexpr FixedMatrix operator-(const FixedMatrix& matrix) {
+        return generate([&](std::size_t i, std::size_t j) { return -matrix.element(i, j); });
+    }
+
+    friend constexpr FixedMatrix operator*(double coeff, const FixedMatrix& matrix) {
+        return generate([&](std::size_t i, std::size_t j) { return coeff * matrix.element(i, j); });
+    }
+
+    friend constexpr FixedMatrix operator*(const FixedMatrix& matrix, double coeff) { return coeff * matrix; }
+
+    template<std::size_t K>
+    friend constexpr FixedMatrix<R, K> operator*(const FixedMatrix& lhs, const FixedMatrix<C, K>& rhs) {
+        return lhs.multiply(rhs);
+    }
+
+    // Transforms a (column) vector
+    friend constexpr FixedVector<R> operator*(const FixedMatrix& matrix, const FixedVector<C>& vec) {
+        return matrix.multiply(vec, std::make_index_sequence<R>());
+    }
+
+    // Exponentiation by squaring
+    friend constexpr FixedMatrix operator^(const FixedMatrix& matrix, std::size_t power) {
+        static_assert(R == C, "This is not Square Matrix!");
+        FixedMatrix result = identity();
+        FixedMatrix base = matrix;
+        while(power) {
+            if(power & 1)
+                result = result * base;
+            power >>= 1;
+            if(power)
+                base = base * base;
+        }
+        return result;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const FixedMatrix& matrix) {
+        return os << ConstMatrixView(matrix);
+    }
+
+    // Class Operators
+    constexpr VectorView operator[](std::size_t idx) {       // Checked by policy (see BoundsCheck.hpp)
+        checkIndexByPolicy(idx, R);
+        return VectorView(elements + idx * C, C);
+    }
+
+    constexpr ConstVectorView operator[](std::size_t idx) const {
+        checkIndexByPolicy(idx, R);
+        return ConstVectorView(elements + idx * C, C);
+    }
+
+    operator MatrixView() { return MatrixView(elements, R, C, C); }
+    operator ConstMatrixView() const { return ConstMatrixView(elements, R, C, C); }
+
+    template<std::size_t, std::size_t>
+    friend class FixedMatrix;
+
+    // Destructor
+    ~FixedMatrix() = default;
+};
+
+template<std::size_t N>
+using FixedSquareMatrix = FixedMatrix<N, N>;
+
+#endif //FIXEDMATRIX_HPP
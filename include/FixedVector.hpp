@@ -0,0 +1,131 @@
+#ifndef FIXEDVECTOR_HPP
+#define FIXEDVECTOR_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "BoundsCheck.hpp"
+#include "Vector.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Fixed-size counterpart of Vector for the small (2D, 3D, 4D, ...) cases. The N components live inside
+// the object, so nothing here touches the heap; dimensions are part of the type, so mismatches are
+// compile errors; and the element-wise loops are unrolled through index sequences.
+// Everything but magnitude(), angle() and printing is constexpr.
+// Converts implicitly to a (Const)VectorView, and explicitly to a Vector: Vector(fixedVector).
+template<std::size_t N>
+class FixedVector {
+    static_assert(N > 0, "Condition didn't match (size > 0)");
+
+private:
+    double comps[N]{};
+
+    template<typename Generator, std::size_t... I>
+    static constexpr FixedVector generate(const Generator& generator, std::index_sequence<I...>) {
+        return FixedVector(generator(I)...);
+    }
+
+    // FixedVector{ generator(0), ..., generator(N - 1) }
+    template<typename Generator>
+    static constexpr FixedVector generate(const Generator& generator) {
+        return generate(generator, std::make_index_sequence<N>());
+    }
+
+    template<std::size_t... I>
+    constexpr double dot(const FixedVector& rhs, std::index_sequence<I...>) const {
+        return ((comps[I] * rhs.comps[I]) + ...);
+    }
+
+public:
+    // Constructors
+    constexpr FixedVector() = default;    // Zero vector
+    template<typename... Components, typename = std::enable_if_t<
+            sizeof...(Components) == N && std::conjunction_v<std::is_arithmetic<Components>...>>>
+    constexpr FixedVector(Components... components) : comps{static_cast<double>(components)...} {}
+    explicit FixedVector(ConstVectorView view) {
+        if(view.getDimension() != N)
+            throw std::invalid_argument("Vector should contain " + std::to_string(N) + " Elements");
+        for(std::size_t i = 0; i < N; i++)
+            comps[i] = view.element(i);
+    }
+
+    // Compound Assignment
+    constexpr FixedVector& operator+=(const FixedVector& rhs) { return *this = *this + rhs; }
+    constexpr FixedVector& operator-=(const FixedVector& rhs) { return *this = *this - rhs; }
+    constexpr FixedVector& operator*=(double coeff) { return *this = *this * coeff; }
+
+    // Methods
+    [[nodiscard]] std::string toString() const {
+        std::ostringstream os;
+        os << *this;
+        return os.str();
+    }
+    [[nodiscard]] double magnitude() const { return std::sqrt(dot(*this)); }
+    [[nodiscard]] constexpr double dot(const FixedVector& rhs) const {   // Dot Product (also spelled lhs * rhs)
+        return dot(rhs, std::make_index_sequence<N>());
+    }
+    [[nodiscard]] static constexpr std::size_t getDimension() { return N; }
+    [[nodiscard]] double angle(const FixedVector& rhs) const {   // In Radians
+        return std::acos(dot(rhs) / (magnitude() * rhs.magnitude()));
+    }
+    [[nodiscard]] constexpr double element(std::size_t i) const { return comps[i]; }   // Unchecked
+
+    // Friend Operators
+    friend constexpr FixedVector operator+(const FixedVector& lhs, const FixedVector& rhs) {
+        return generate([&](std::size_t i) { return lhs.comps[i] + rhs.comps[i]; });
+    }
+
+    friend constexpr FixedVector operator-(const FixedVector& lhs, const FixedVector& rhs) {
+        return generate([&](std::size_t i) { return lhs.comps[i] - rhs.comps[i]; });
+    }
+
+    friend constexpr FixedVector operator-(const FixedVector& vec) {
+        return generate([&](std::size_t i) { return -vec.comps[i]; });
+    }
+
+    friend constexpr FixedVector operator*(double coeff, const FixedVector& vec) {
+        return generate([&](std::size_t i) { return coeff * vec.comps[i]; });
+    }
+
+    friend constexpr FixedVector operator*(const FixedVector& vec, double coeff) { return coeff * vec; }
+
+    friend constexpr double operator*(const FixedVector& lhs, const FixedVector& rhs) { return lhs.dot(rhs); }
+
+    // Cross Product
+    friend constexpr FixedVector operator^(const FixedVector& lhs, const FixedVector& rhs) {
+        static_assert(N == 3, "Cross Product is only defined for two 3 dimensional vectors!");
+        return FixedVector(lhs.comps[1] * rhs.comps[2] - rhs.comps[1] * lhs.comps[2],
+                           rhs.comps[0] * lhs.comps[2] - lhs.comps[0] * rhs.comps[2],
+                           lhs.comps[0] * rhs.comps[1] - rhs.comps[0] * lhs.comps[1]);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const FixedVector& vec) {
+        return os << ConstVectorView(vec);
+    }
+
+    // Class Operators
+    constexpr double& operator[](std::size_t idx) {      // Checked by policy (see BoundsCheck.hpp)
+        checkIndexByPolicy(idx, N);
+        return comps[idx];
+    }
+
+    constexpr const double& operator[](std::size_t idx) const {
+        checkIndexByPolicy(idx, N);
+        return comps[idx];
+    }
+
+    constexpr operator VectorView() { return VectorView(comps, N); }
+    constexpr operator ConstVectorView() const { return ConstVectorView(comps, N); }
+
+    // Destructor
+    ~FixedVector() = default;
+};
+
+#endif //FIXEDVECTOR_HPP
@@ -0,0 +1,46 @@
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+#include <cstddef>
+
+// Read-only operand of the multiply kernel: element (i, j) lives at data[i * rowStride + j * columnStride].
+// Arbitrary strides let the kernel consume row-major, column-major and sub-block operands alike.
+template<typename T>
+struct BasicGemmOperand {
+    const T* data{};
+    std::size_t rowStride{};
+    std::size_t columnStride{};
+};
+
+using GemmOperand = BasicGemmOperand<double>;
+
+// Destination of the multiply kernel, always row-major with the given row stride.
+template<typename T>
+struct BasicGemmResult {
+    T* data{};
+    std::size_t rowStride{};
+};
+
+using GemmResult = BasicGemmResult<double>;
+
+// Shape of the product: C is (rowCount x columnCount), A is (rowCount x depth), B is (depth x columnCount).
+struct GemmShape {
+    std::size_t rowCount{};
+    std::size_t columnCount{};
+    std::size_t depth{};
+};
+
+// C = alpha * A * B + beta * C
+// Cache-blocked (KC x MC panels of A kept in L2, KC x NR slivers of B in L1) with a register-tiled
+// MR x NR micro-kernel. When beta == 0, C is overwritten and its previous contents are never read.
+// Large products split their output tiles across ThreadPool::instance(); every element is accumulated
+// in the same order whatever the thread count, so results are bitwise reproducible.
+void blockedGemm(GemmShape shape, double alpha, GemmOperand a, GemmOperand b, double beta, GemmResult c);
+// Mixed precision: float operands are widened to double while they are packed, so the product runs
+// through the same double micro-kernel (and accumulates in double) while A and B are read at half the bandwidth.
+// Each MC-row tile of C is accumulated in a per-thread double workspace and rounded to float once, when it is
+// stored (straight from the registers when depth <= KC), so steady-state calls do not allocate.
+void blockedGemm(GemmShape shape, double alpha, BasicGemmOperand<float> a, BasicGemmOperand<float> b,
+                 double beta, BasicGemmResult<float> c);
+
+#endif //GEMM_HPP
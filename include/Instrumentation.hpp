@@ -0,0 +1,136 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Per-operation accounting for the public operations of Vector, Matrix and SquareMatrix: calls, wall time,
+// FLOPs, bytes allocated and bytes of elements copied.
+// Compiled in only when LINEAROBJECTS_INSTRUMENTATION is defined (CMake option
+// LINEAROBJECTS_ENABLE_INSTRUMENTATION). Otherwise LINEAROBJECTS_INSTRUMENT expands to nothing, its arguments
+// are never evaluated, and the functions below return zeros and do nothing.
+// When enabled, an operation costs two clock reads and a few relaxed atomic adds to counters owned by the
+// calling thread (no shared cache lines, no locks). Only the outermost operation running on a thread is
+// recorded, so nested calls (the Matrix constructor inside operator*) are not counted twice and the times
+// add up. Lazy expressions (+, -, coefficients, see MatrixExpression.hpp) are evaluated inline and not counted.
+
+enum class InstrumentedOperation : std::size_t {
+    VectorConstruct,
+    VectorCopy,
+    VectorScale,
+    VectorToString,
+    VectorMagnitude,
+    VectorDot,
+    VectorAngle,
+    VectorCross,
+    VectorGetMatrix,
+    MatrixConstruct,
+    MatrixCopy,
+    MatrixScale,
+    MatrixToString,
+    MatrixTranspose,
+    MatrixTransposeInPlace,
+    MatrixRotate,
+    MatrixSwapRows,
+    MatrixSwapColumns,
+    MatrixSave,
+    MatrixLoad,
+    MatrixGetSubMatrix,
+    MatrixGetRow,
+    MatrixGetColumn,
+    MatrixGetSubRow,
+    MatrixGetSubColumn,
+    MatrixSetRow,
+    MatrixSetColumn,
+    MatrixSetSubRow,
+    MatrixSetSubColumn,
+    MatrixSetSubMatrix,
+    MatrixMultiply,
+    Gemm,
+    SquareMatrixIdentity,
+    SquareMatrixTranspose,
+    SquareMatrixMultiply,
+    StrassenMultiply,
+    SquareMatrixPower,
+    SquareMatrixLU,
+    SquareMatrixDeterminant,
+    SquareMatrixInverse,
+    SquareMatrixSolve,
+    Count
+};
+
+constexpr std::size_t INSTRUMENTED_OPERATION_COUNT = static_cast<std::size_t>(InstrumentedOperation::Count);
+
+[[nodiscard]] const char* operationName(InstrumentedOperation operation);   // e.g. "Matrix::transpose"
+
+struct OperationStats {
+    std::uint64_t calls{};
+    std::uint64_t nanoseconds{};      // Wall time
+    std::uint64_t flops{};            // Nominal count of the algorithm (2mnk for a product, also on the Strassen path)
+    std::uint64_t bytesAllocated{};   // Through AlignedAllocator on the calling thread (see MemoryResource.hpp)
+    std::uint64_t bytesCopied{};      // Elements copied or moved between buffers, in bytes
+};
+
+// Indexed by InstrumentedOperation
+using InstrumentationSnapshot = std::array<OperationStats, INSTRUMENTED_OPERATION_COUNT>;
+
+[[nodiscard]] constexpr bool instrumentationEnabled() {
+#ifdef LINEAROBJECTS_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+[[nodiscard]] InstrumentationSnapshot instrumentationSnapshot();   // Totals over all threads, exited ones included
+void resetInstrumentation();
+// {"operations": [{"name": ..., "calls": ..., "nanoseconds": ..., ...}, ...]}, operations never called left out
+[[nodiscard]] std::string instrumentationJson(const InstrumentationSnapshot& snapshot);
+
+struct TraceEvent {
+    InstrumentedOperation operation{};
+    std::uint64_t startNanoseconds{};   // std::chrono::steady_clock
+    OperationStats stats{};             // calls == 1
+};
+
+// Called on the thread that ran the operation, right after it finished (also when it threw). It must not
+// throw and should be quick; it runs inside the caller's operation. nullptr removes it. Set it before the
+// workload starts: replacing it while operations run may pair the new callback with the old userData once.
+using TraceCallback = void (*)(const TraceEvent& event, void* userData);
+void setTraceCallback(TraceCallback callback, void* userData = nullptr);
+
+#ifdef LINEAROBJECTS_INSTRUMENTATION
+
+// Records one operation from construction to destruction. Used through LINEAROBJECTS_INSTRUMENT.
+class OperationScope {
+private:
+    InstrumentedOperation operation;
+    std::uint64_t flops;
+    std::uint64_t bytesCopied;
+    std::uint64_t start{};
+    std::uint64_t allocatedAtStart{};
+    bool outermost;
+
+public:
+    // Constructors
+    explicit OperationScope(InstrumentedOperation op, std::uint64_t flopCount = 0, std::uint64_t copiedBytes = 0) noexcept;
+
+    // (Move & Copy) (Constructor & Assignment)
+    OperationScope(const OperationScope&) = delete;
+    OperationScope& operator=(const OperationScope&) = delete;
+
+    // Destructor
+    ~OperationScope();
+};
+
+#define LINEAROBJECTS_INSTRUMENT(...) const OperationScope instrumentationScope(__VA_ARGS__)
+
+#else
+
+#define LINEAROBJECTS_INSTRUMENT(...) static_cast<void>(0)
+
+#endif
+
+#endif //INSTRUMENTATION_HPP
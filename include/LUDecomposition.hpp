@@ -0,0 +1,49 @@
+#ifndef LUDECOMPOSITION_HPP
+#define LUDECOMPOSITION_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "SquareMatrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// PA = LU of one fixed SquareMatrix, with partial (row) pivoting. L is unit lower triangular, U upper
+// triangular; both are packed into a single n x n matrix (L's unit diagonal is not stored).
+// The factorization is blocked and right-looking: each panel of columns is factored on its own, and the
+// trailing part of the matrix is updated with one call to the multiply kernel (Gemm.hpp) per panel, so
+// large factorizations run at about the kernel's speed and on the thread pool.
+// Factor once and reuse it: every solve() afterwards costs O(n^2) per right-hand side instead of O(n^3).
+// The matrix is copied in; later changes to the original are not seen.
+class LUDecomposition {
+private:
+    SquareMatrix factors;                    // L below the diagonal, U on and above it
+    std::vector<std::size_t> permutation{};  // Row i of PA is row permutation[i] of A
+    int pivotSign{1};                        // Sign of the permutation, +1 or -1
+    bool singular{false};                    // Some pivot was exactly zero
+
+    void factorize();
+    void solveInPlace(MatrixView rhs) const;   // Permuted right-hand sides in, solutions out
+
+public:
+    // Constructors
+    explicit LUDecomposition(const SquareMatrix& matrix);
+
+    // Methods
+    [[nodiscard]] double determinant() const;
+    [[nodiscard]] Vector solve(ConstVectorView rhs) const;     // x with A x = rhs
+    [[nodiscard]] Matrix solve(ConstMatrixView rhs) const;     // X with A X = rhs, one column per system
+    [[nodiscard]] SquareMatrix inverse() const;
+    [[nodiscard]] SquareMatrix lower() const;                  // L, unit diagonal included
+    [[nodiscard]] SquareMatrix upper() const;                  // U
+
+    // Getters
+    [[nodiscard]] const SquareMatrix& getFactors() const;
+    [[nodiscard]] const std::vector<std::size_t>& getPermutation() const;
+    [[nodiscard]] bool isSingular() const;
+
+    // Destructor
+    ~LUDecomposition() = default;
+};
+
+#endif //LUDECOMPOSITION_HPP
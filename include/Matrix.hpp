@@ -1,80 +1,365 @@
 #ifndef MATRIX_HPP
 #define MATRIX_HPP
 
+#include <algorithm>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <ostream>
 
+#include "AlignedAllocator.hpp"
+#include "BoundsCheck.hpp"
+#include "Execution.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixSize.hpp"
+#include "MatrixView.hpp"
+#include "Scalar.hpp"
+#include "Transpose.hpp"
 #include "Vector.hpp"
 
 // Note: All Objects Are Zero-Origin Based !
 
-class MatrixSize {
-public:
-    std::size_t rowCount{};
-    std::size_t columnCount{};
+// Matrix rows are plain views (see VectorView.hpp)
+using MatrixRow = VectorView;
+using ConstMatrixRow = ConstVectorView;
 
-    MatrixSize() = default;
-    [[nodiscard]] bool validate() const;
-    ~MatrixSize() = default;
-};
+// Products of views (sub-blocks, rows or columns as 1 x n or n x 1 blocks, ...); Matrices convert implicitly.
+// gemm() computes into a temporary when C overlaps A or B. float products keep float storage but compute
+// in double (the GEMM kernel widens elements while packing them), int products accumulate in long long.
+// int gemm() applies integer alpha and beta exactly and rounds to nearest otherwise; it throws
+// std::overflow_error when an element of C does not fit in an int (C is then partially updated).
+Matrix operator*(ConstMatrixView lhs, ConstMatrixView rhs);
+FloatMatrix operator*(BasicMatrixView<const float> lhs, BasicMatrixView<const float> rhs);
+IntMatrix operator*(BasicMatrixView<const int> lhs, BasicMatrixView<const int> rhs);
+void gemm(double alpha, ConstMatrixView a, ConstMatrixView b, double beta, MatrixView c);
+void gemm(double alpha, BasicMatrixView<const float> a, BasicMatrixView<const float> b,
+          double beta, BasicMatrixView<float> c);
+void gemm(double alpha, BasicMatrixView<const int> a, BasicMatrixView<const int> b,
+          double beta, BasicMatrixView<int> c);
 
-class Matrix {
+// Owning row-major matrix of T (double, float or int; see Scalar.hpp for the Matrix / FloatMatrix / IntMatrix aliases).
+template<typename T>
+class BasicMatrix : public MatrixExpression<BasicMatrix<T>> {
 protected:
-    std::vector<Vector> data{};
+    BasicAlignedBuffer<T> data{};   // Row-major, element (i, j) lives at data[i * stride + j]
     MatrixSize size{};
+    std::size_t stride{};   // Distance (in elements) between the starts of two consecutive rows
+
+    T* rowPointer(std::size_t idx) { return data.data() + idx * stride; }
+    [[nodiscard]] const T* rowPointer(std::size_t idx) const { return data.data() + idx * stride; }
+
+    template<typename E>
+    void assign(const E& expr, std::size_t rowBegin, std::size_t rowEnd);
+    template<typename E>
+    void accumulate(const E& expr, double sign);
+    template<typename E>
+    bool assignThroughTemporary(const E& expr);
 
 public:
+    using Scalar = T;
+
     // Constructors
-    Matrix(std::size_t rowCount, std::size_t columnCount);
-    explicit Matrix(MatrixSize matSize);
-    Matrix(std::initializer_list<std::initializer_list<double>> matrixRows);
-    explicit Matrix(const std::vector<Vector>& matrixRows);
-    explicit Matrix(const std::vector<std::vector<double>>& matrixRows);
+    BasicMatrix(std::size_t rowCount, std::size_t columnCount);
+    explicit BasicMatrix(MatrixSize matSize);
+    BasicMatrix(std::initializer_list<std::initializer_list<T>> matrixRows);
+    explicit BasicMatrix(const std::vector<BasicVector<T>>& matrixRows);
+    explicit BasicMatrix(const std::vector<std::vector<T>>& matrixRows);
+    BasicMatrix(std::size_t rowCount, std::size_t columnCount, std::pmr::memory_resource* resource);   // Zero matrix on resource
+    BasicMatrix(std::size_t rowCount, std::size_t columnCount, BasicAlignedBuffer<T>&& elements);   // Adopts row-major elements
+    template<typename E, typename = std::enable_if_t<!isMatrixView<E> && std::is_same_v<typename E::Scalar, T>>>
+    BasicMatrix(const MatrixExpression<E>& expr);   // Evaluates a lazy expression in a single pass
+    template<typename E, typename = std::enable_if_t<std::is_same_v<typename E::Scalar, T>>>
+    BasicMatrix(ExecutionPolicy policy, const MatrixExpression<E>& expr);   // The same (or a view copy), across threads
+    explicit BasicMatrix(BasicMatrixView<const T> view);   // Owning copy of a view (or of anything that converts to one)
+    template<typename U, typename = std::enable_if_t<!std::is_same_v<U, T>>>
+    explicit BasicMatrix(const BasicMatrix<U>& matrix);   // Element type conversion (static_cast of each element)
 
     // (Move & Copy) (Constructor & Assignment)
-    Matrix(const Matrix& matrix);
-    Matrix(const Matrix&& matrix) noexcept;
-    Matrix& operator=(const Matrix& matrix);
-    Matrix& operator=(Matrix&& matrix) noexcept;
+    BasicMatrix(const BasicMatrix& matrix);
+    BasicMatrix(BasicMatrix&& matrix) noexcept;
+    BasicMatrix& operator=(const BasicMatrix& matrix);
+    BasicMatrix& operator=(BasicMatrix&& matrix);   // Copies (and may throw) when the memory resources differ
+    template<typename E>
+    BasicMatrix& operator=(const MatrixExpression<E>& expr);
+    template<typename E>
+    BasicMatrix& assign(ExecutionPolicy policy, const MatrixExpression<E>& expr);   // operator=, see Execution.hpp
+
+    // Compound Assignment (in place, never allocates)
+    template<typename E>
+    BasicMatrix& operator+=(const MatrixExpression<E>& expr);
+    template<typename E>
+    BasicMatrix& operator-=(const MatrixExpression<E>& expr);
+    BasicMatrix& operator*=(double coeff);
 
     // Methods
     [[nodiscard]] std::string toString() const;
-    virtual Matrix& transpose();
-    virtual Matrix& swapRows(std::size_t idx1, std::size_t idx2);
-    virtual Matrix& swapColumns(std::size_t idx1, std::size_t idx2);
-    Matrix& rotate();
+    virtual BasicMatrix& transpose();         // Cache-oblivious copy into a fresh buffer (transposed() copies nothing)
+    BasicMatrix& transposeInPlace();          // No second buffer (one bit per element of bookkeeping), slower
+    virtual BasicMatrix& swapRows(std::size_t idx1, std::size_t idx2);
+    virtual BasicMatrix& swapColumns(std::size_t idx1, std::size_t idx2);
+    BasicMatrix& rotate();                    // 90 degrees clockwise, in place
+    void save(const std::string& path) const;                     // Binary matrix file, see MatrixFile.hpp
+    [[nodiscard]] static BasicMatrix load(const std::string& path);    // (Elements are stored as double)
 
     // Getters
-    [[nodiscard]] Vector getRow(std::size_t idx) const;
-    [[nodiscard]] Vector getColumn(std::size_t idx) const;
-    [[nodiscard]] Vector getSubRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd) const;
-    [[nodiscard]] Vector getSubColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd) const;
-    [[nodiscard]] Matrix getSubMatrix(std::size_t rowStart, std::size_t rowEnd,
-                                      std::size_t columnStart, std::size_t columnEnd) const;
-    [[nodiscard]] const MatrixSize& getDimension() const;
+    [[nodiscard]] BasicVector<T> getRow(std::size_t idx) const;
+    [[nodiscard]] BasicVector<T> getColumn(std::size_t idx) const;
+    [[nodiscard]] BasicVector<T> getSubRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd) const;
+    [[nodiscard]] BasicVector<T> getSubColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd) const;
+    [[nodiscard]] BasicMatrix getSubMatrix(std::size_t rowStart, std::size_t rowEnd,
+                                           std::size_t columnStart, std::size_t columnEnd) const;
+    [[nodiscard]] const MatrixSize& getDimension() const { return size; }
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;   // Where the elements live (see MemoryResource.hpp)
+    [[nodiscard]] T element(std::size_t i, std::size_t j) const { return data[i * stride + j]; }   // Unchecked
+
+    // Element Access (operator[] checks by policy, at() always, the rest never; see BoundsCheck.hpp)
+    [[nodiscard]] BasicVectorView<T> at(std::size_t idx) { return row(idx); }     // Then .at(j) for a checked element
+    [[nodiscard]] BasicVectorView<const T> at(std::size_t idx) const { return row(idx); }
+    [[nodiscard]] T* getData() { return data.data(); }              // Row i starts at getData() + i * getStride()
+    [[nodiscard]] const T* getData() const { return data.data(); }
+    [[nodiscard]] std::size_t getStride() const { return stride; }
+    [[nodiscard]] Span<T> rowSpan(std::size_t idx) {
+        checkIndexByPolicy(idx, size.rowCount);
+        return Span<T>(rowPointer(idx), size.columnCount);
+    }
+    [[nodiscard]] Span<const T> rowSpan(std::size_t idx) const {
+        checkIndexByPolicy(idx, size.rowCount);
+        return Span<const T>(rowPointer(idx), size.columnCount);
+    }
+
+    // Views (non-owning, no copies; same bounds as the getters above, see MatrixView.hpp)
+    [[nodiscard]] BasicMatrixView<T> view();
+    [[nodiscard]] BasicMatrixView<const T> view() const;
+    [[nodiscard]] BasicVectorView<T> row(std::size_t idx);
+    [[nodiscard]] BasicVectorView<const T> row(std::size_t idx) const;
+    [[nodiscard]] BasicVectorView<T> column(std::size_t idx);
+    [[nodiscard]] BasicVectorView<const T> column(std::size_t idx) const;
+    [[nodiscard]] BasicVectorView<T> subRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd);
+    [[nodiscard]] BasicVectorView<const T> subRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd) const;
+    [[nodiscard]] BasicVectorView<T> subColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd);
+    [[nodiscard]] BasicVectorView<const T> subColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd) const;
+    [[nodiscard]] BasicMatrixView<T> subMatrix(std::size_t rowStart, std::size_t rowEnd,
+                                               std::size_t columnStart, std::size_t columnEnd);
+    [[nodiscard]] BasicMatrixView<const T> subMatrix(std::size_t rowStart, std::size_t rowEnd,
+                                                     std::size_t columnStart, std::size_t columnEnd) const;
+    [[nodiscard]] BasicMatrixView<T> transposed();              // O(1): A.transposed() * B multiplies A^T B in place
+    [[nodiscard]] BasicMatrixView<const T> transposed() const;
 
     // Setters
-    virtual Matrix& setRow(std::size_t idx, const Vector& row);
-    virtual Matrix& setColumn(std::size_t idx, const Vector& column);
-    virtual Matrix& setSubRow(std::size_t idx, std::size_t columnStart, const Vector &subRow);
-    virtual Matrix& setSubColumn(std::size_t idx, std::size_t rowStart, const Vector &subColumn);
-    Matrix& setSubMatrix(std::size_t rowStart, std::size_t columnStart, const Matrix& matrix);
-
-    // Friend Operators
-    friend std::ostream& operator<<(std::ostream& os, const Matrix& matrix);
-    friend Matrix operator*(const Matrix& lhs, const Matrix& rhs);
-    friend Matrix operator*(const Matrix& lhs, double coeff);
-    friend Matrix operator*(double coeff, const Matrix& lhs);
-    friend Matrix operator+(const Matrix& lhs, const Matrix& rhs);
+    virtual BasicMatrix& setRow(std::size_t idx, const BasicVector<T>& row);
+    virtual BasicMatrix& setColumn(std::size_t idx, const BasicVector<T>& column);
+    virtual BasicMatrix& setSubRow(std::size_t idx, std::size_t columnStart, const BasicVector<T> &subRow);
+    virtual BasicMatrix& setSubColumn(std::size_t idx, std::size_t rowStart, const BasicVector<T> &subColumn);
+    BasicMatrix& setSubMatrix(std::size_t rowStart, std::size_t columnStart, const BasicMatrix& matrix);
+    BasicMatrix& setColumn(ExecutionPolicy policy, std::size_t idx, const BasicVector<T>& column);
+    BasicMatrix& setSubMatrix(ExecutionPolicy policy, std::size_t rowStart, std::size_t columnStart, const BasicMatrix& matrix);
+
+    // Friend Operators (Element-wise arithmetic is lazy, see MatrixExpression.hpp)
+    friend std::ostream& operator<<(std::ostream& os, const BasicMatrix& matrix) {
+        for(std::size_t i = 0; i < matrix.size.rowCount; i++)
+            os << matrix[i];
+        return os;
+    }
+    friend BasicMatrix operator*(const BasicMatrix& lhs, const BasicMatrix& rhs) {
+        return lhs.view() * rhs.view();
+    }
+    // C = alpha * A * B + beta * C, written into the existing C (allocation-free unless C is A or B)
+    friend void gemm(double alpha, const BasicMatrix& a, const BasicMatrix& b, double beta, BasicMatrix& c) {
+        gemm(alpha, a.view(), b.view(), beta, c.view());
+    }
 
     // Class Operators
-    Vector& operator[]( std::size_t idx );
-    const Vector& operator[]( std::size_t idx) const;
+    BasicVectorView<T> operator[](std::size_t idx) {
+        checkIndexByPolicy(idx, size.rowCount);
+        return BasicVectorView<T>(rowPointer(idx), size.columnCount);
+    }
+    BasicVectorView<const T> operator[](std::size_t idx) const {
+        checkIndexByPolicy(idx, size.rowCount);
+        return BasicVectorView<const T>(rowPointer(idx), size.columnCount);
+    }
+    operator BasicMatrixView<T>();
+    operator BasicMatrixView<const T>() const;
 
     // Destructor
-    virtual ~Matrix() = default;
+    virtual ~BasicMatrix() = default;
 };
 
+template<typename T>
+template<typename E, typename>
+BasicMatrix<T>::BasicMatrix(const MatrixExpression<E>& expr) {
+    size = expr.derived().getDimension();
+    stride = size.columnCount;
+    data.resize(size.rowCount * stride);
+    assign(expr.derived(), 0, size.rowCount);
+}
+
+template<typename T>
+template<typename E, typename>
+BasicMatrix<T>::BasicMatrix(ExecutionPolicy policy, const MatrixExpression<E>& expr) {
+    size = expr.derived().getDimension();
+    stride = size.columnCount;
+    data.resize(size.rowCount * stride);
+    forEachChunk(policy, size.rowCount, chunkRows(size.columnCount), [&](std::size_t rowBegin, std::size_t rowEnd) {
+        assign(expr.derived(), rowBegin, rowEnd);
+    });
+}
+
+template<typename T>
+template<typename U, typename>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix<U>& matrix) {
+    size = matrix.getDimension();
+    stride = size.columnCount;
+    data.resize(size.rowCount * stride);
+    for(std::size_t i = 0; i < size.rowCount; i++)
+        for(std::size_t j = 0; j < size.columnCount; j++)
+            data[i * stride + j] = static_cast<T>(matrix.element(i, j));
+}
+
+template<typename T>
+template<typename E>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const MatrixExpression<E>& expr) {
+    static_assert(std::is_same_v<typename E::Scalar, T>, "Operands of different element types");
+    const MatrixSize& exprSize = expr.derived().getDimension();
+    if(exprSize.rowCount != size.rowCount || exprSize.columnCount != size.columnCount) {
+        BasicMatrix result(expr.derived());
+        return *this = std::move(result);
+    }
+    if(!assignThroughTemporary(expr.derived()))
+        assign(expr.derived(), 0, size.rowCount);
+    return *this;
+}
+
+template<typename T>
+template<typename E>
+BasicMatrix<T>& BasicMatrix<T>::assign(ExecutionPolicy policy, const MatrixExpression<E>& expr) {
+    static_assert(std::is_same_v<typename E::Scalar, T>, "Operands of different element types");
+    const MatrixSize& exprSize = expr.derived().getDimension();
+    if(exprSize.rowCount != size.rowCount || exprSize.columnCount != size.columnCount) {
+        BasicMatrix result(policy, expr.derived());
+        return *this = std::move(result);
+    }
+    if(assignThroughTemporary(expr.derived()))
+        return *this;
+    forEachChunk(policy, size.rowCount, chunkRows(size.columnCount), [&](std::size_t rowBegin, std::size_t rowEnd) {
+        assign(expr.derived(), rowBegin, rowEnd);
+    });
+    return *this;
+}
+
+// An expression that reads this matrix at other positions than it writes (A = A.transposed() + B) would see
+// elements it already overwrote: it is evaluated into a temporary, except A = A.transposed() for square A,
+// which is transposed in place. Returns whether it took care of the assignment.
+template<typename T>
+template<typename E>
+bool BasicMatrix<T>::assignThroughTemporary(const E& expr) {
+    if(!overlapsUnsafely(view(), expr))
+        return false;
+    if constexpr(isMatrixView<E>) {
+        if(expr.data() == data.data() && expr.getStride() == 1 && expr.getColumnStride() == stride &&
+           size.rowCount == size.columnCount) {
+            transposeSquareInPlace(size.rowCount, data.data(), stride);
+            return true;
+        }
+    }
+    BasicMatrix result(expr);
+    *this = std::move(result);
+    return true;
+}
+
+// Single-pass, row by row evaluation of rows [rowBegin, rowEnd); the destination may appear in the
+// expression at the same positions (A = A + B), and disjoint row ranges may be evaluated concurrently. Plain sums and scalings
+// of double Matrices go through the SIMD kernels one row at a time, transposed views through the
+// cache-oblivious transpose (see Transpose.hpp).
+template<typename T>
+template<typename E>
+void BasicMatrix<T>::assign(const E& expr, std::size_t rowBegin, std::size_t rowEnd) {
+    if constexpr(isMatrixView<E>) {
+        if(!expr.isRowMajor() && expr.getStride() == 1) {
+            transposeOutOfPlace(size.columnCount, rowEnd - rowBegin, expr.data() + rowBegin, expr.getColumnStride(),
+                                rowPointer(rowBegin), stride);
+            return;
+        }
+    }
+    const VectorKernels& kernels = activeVectorKernels();
+    for(std::size_t i = rowBegin; i < rowEnd; i++) {
+        T* row = rowPointer(i);
+        if constexpr(std::is_same_v<E, MatrixSum<Matrix, Matrix>>) {
+            kernels.add(expr.left().rowPointer(i), expr.right().rowPointer(i), row, size.columnCount);
+        } else if constexpr(std::is_same_v<E, MatrixScaled<Matrix>>) {
+            kernels.scale(expr.operand().rowPointer(i), expr.coefficient(), row, size.columnCount);
+        } else if constexpr(isMatrixView<E>) {
+            if(expr.isRowMajor()) {
+                const T* source = expr.data() + i * expr.getStride();
+                std::copy(source, source + size.columnCount, row);
+            } else {
+                for(std::size_t j = 0; j < size.columnCount; j++)
+                    row[j] = expr.element(i, j);
+            }
+        } else {
+            for(std::size_t j = 0; j < size.columnCount; j++)
+                row[j] = expr.element(i, j);
+        }
+    }
+}
+
+template<typename T>
+template<typename E>
+BasicMatrix<T>& BasicMatrix<T>::operator+=(const MatrixExpression<E>& expr) {
+    static_assert(std::is_same_v<typename E::Scalar, T>, "Operands of different element types");
+    const MatrixSize& exprSize = expr.derived().getDimension();
+    if(exprSize.rowCount != size.rowCount || exprSize.columnCount != size.columnCount)
+        throw std::invalid_argument("Addition of matrices with different sizes are not defined!");
+    if(overlapsUnsafely(view(), expr.derived()))    // A += A.transposed()
+        accumulate(BasicMatrix(expr.derived()), 1.0);
+    else
+        accumulate(expr.derived(), 1.0);
+    return *this;
+}
+
+template<typename T>
+template<typename E>
+BasicMatrix<T>& BasicMatrix<T>::operator-=(const MatrixExpression<E>& expr) {
+    static_assert(std::is_same_v<typename E::Scalar, T>, "Operands of different element types");
+    const MatrixSize& exprSize = expr.derived().getDimension();
+    if(exprSize.rowCount != size.rowCount || exprSize.columnCount != size.columnCount)
+        throw std::invalid_argument("Subtraction of matrices with different sizes are not defined!");
+    if(overlapsUnsafely(view(), expr.derived()))
+        accumulate(BasicMatrix(expr.derived()), -1.0);
+    else
+        accumulate(expr.derived(), -1.0);
+    return *this;
+}
+
+// this += sign * expr, row by row; double Matrices, scaled Matrices and row-major views become axpy passes.
+template<typename T>
+template<typename E>
+void BasicMatrix<T>::accumulate(const E& expr, double sign) {
+    const VectorKernels& kernels = activeVectorKernels();
+    for(std::size_t i = 0; i < size.rowCount; i++) {
+        T* row = rowPointer(i);
+        if constexpr(std::is_same_v<E, Matrix>) {
+            kernels.axpy(sign, expr.rowPointer(i), row, size.columnCount);
+        } else if constexpr(std::is_same_v<E, MatrixScaled<Matrix>>) {
+            kernels.axpy(sign * expr.coefficient(), expr.operand().rowPointer(i), row, size.columnCount);
+        } else if constexpr(isMatrixView<E> && std::is_same_v<T, double>) {
+            if(expr.isRowMajor()) {
+                kernels.axpy(sign, expr.data() + i * expr.getStride(), row, size.columnCount);
+            } else {
+                for(std::size_t j = 0; j < size.columnCount; j++)
+                    row[j] += sign * expr.element(i, j);
+            }
+        } else {
+            for(std::size_t j = 0; j < size.columnCount; j++)
+                row[j] = roundToScalar<T>(row[j] + sign * expr.element(i, j));
+        }
+    }
+}
+
+extern template class BasicMatrix<double>;
+extern template class BasicMatrix<float>;
+extern template class BasicMatrix<int>;
+
 #endif //MATRIX_HPP
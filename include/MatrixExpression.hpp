@@ -0,0 +1,154 @@
+#ifndef MATRIXEXPRESSION_HPP
+#define MATRIXEXPRESSION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Scalar.hpp"
+
+class MatrixSize;
+
+// Lazy element-wise matrix arithmetic, the Matrix counterpart of VectorExpression.hpp:
+// `a * A + b * B + C` is evaluated in one pass over the destination, without temporaries.
+// Matrix products stay eager; they go through the GEMM kernel. As for vectors, the operands of a node
+// must share their Scalar (element) type.
+template<typename E>
+class MatrixExpression {
+protected:
+    MatrixExpression() = default;
+    MatrixExpression(const MatrixExpression&) = default;
+    MatrixExpression& operator=(const MatrixExpression&) = default;
+    ~MatrixExpression() = default;
+
+public:
+    [[nodiscard]] const E& derived() const { return static_cast<const E&>(*this); }
+};
+
+// Matrices (and SquareMatrices, through their Matrix base) are held by reference, nodes by value.
+template<typename E>
+struct MatrixOperand {
+    using type = const E;
+};
+
+template<typename T>
+struct MatrixOperand<BasicMatrix<T>> {
+    using type = const BasicMatrix<T>&;
+};
+
+template<typename L, typename R>
+class MatrixSum : public MatrixExpression<MatrixSum<L, R>> {
+    static_assert(std::is_same_v<typename L::Scalar, typename R::Scalar>, "Operands of different element types");
+
+private:
+    typename MatrixOperand<L>::type lhs;
+    typename MatrixOperand<R>::type rhs;
+
+public:
+    using Scalar = typename L::Scalar;
+
+    MatrixSum(const L& left, const R& right) : lhs(left), rhs(right) {
+        if(lhs.getDimension().rowCount != rhs.getDimension().rowCount ||
+           lhs.getDimension().columnCount != rhs.getDimension().columnCount)
+            throw std::invalid_argument("Addition of matrices with different sizes are not defined!");
+    }
+
+    [[nodiscard]] const MatrixSize& getDimension() const { return lhs.getDimension(); }
+    [[nodiscard]] Scalar element(std::size_t i, std::size_t j) const { return lhs.element(i, j) + rhs.element(i, j); }
+    [[nodiscard]] const L& left() const { return lhs; }
+    [[nodiscard]] const R& right() const { return rhs; }
+};
+
+template<typename L, typename R>
+class MatrixDifference : public MatrixExpression<MatrixDifference<L, R>> {
+    static_assert(std::is_same_v<typename L::Scalar, typename R::Scalar>, "Operands of different element types");
+
+private:
+    typename MatrixOperand<L>::type lhs;
+    typename MatrixOperand<R>::type rhs;
+
+public:
+    using Scalar = typename L::Scalar;
+
+    MatrixDifference(const L& left, const R& right) : lhs(left), rhs(right) {
+        if(lhs.getDimension().rowCount != rhs.getDimension().rowCount ||
+           lhs.getDimension().columnCount != rhs.getDimension().columnCount)
+            throw std::invalid_argument("Subtraction of matrices with different sizes are not defined!");
+    }
+
+    [[nodiscard]] const MatrixSize& getDimension() const { return lhs.getDimension(); }
+    [[nodiscard]] Scalar element(std::size_t i, std::size_t j) const { return lhs.element(i, j) - rhs.element(i, j); }
+    [[nodiscard]] const L& left() const { return lhs; }
+    [[nodiscard]] const R& right() const { return rhs; }
+};
+
+template<typename E>
+class MatrixScaled : public MatrixExpression<MatrixScaled<E>> {
+private:
+    double coeff{};
+    typename MatrixOperand<E>::type matrix;
+
+public:
+    using Scalar = typename E::Scalar;
+
+    MatrixScaled(double coefficient, const E& operand) : coeff(coefficient), matrix(operand) {}
+
+    [[nodiscard]] const MatrixSize& getDimension() const { return matrix.getDimension(); }
+    [[nodiscard]] Scalar element(std::size_t i, std::size_t j) const {
+        return roundToScalar<Scalar>(coeff * matrix.element(i, j));
+    }
+    [[nodiscard]] double coefficient() const { return coeff; }
+    [[nodiscard]] const E& operand() const { return matrix; }
+};
+
+// Calls visit(operand) for every Matrix and view an expression reads (the leaves of its tree).
+template<typename E, typename Visit>
+void forEachOperand(const E& operand, const Visit& visit) {
+    visit(operand);
+}
+
+template<typename L, typename R, typename Visit>
+void forEachOperand(const MatrixSum<L, R>& expr, const Visit& visit) {
+    forEachOperand(expr.left(), visit);
+    forEachOperand(expr.right(), visit);
+}
+
+template<typename L, typename R, typename Visit>
+void forEachOperand(const MatrixDifference<L, R>& expr, const Visit& visit) {
+    forEachOperand(expr.left(), visit);
+    forEachOperand(expr.right(), visit);
+}
+
+template<typename E, typename Visit>
+void forEachOperand(const MatrixScaled<E>& expr, const Visit& visit) {
+    forEachOperand(expr.operand(), visit);
+}
+
+// Operators
+
+template<typename L, typename R>
+MatrixSum<L, R> operator+(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+    return MatrixSum<L, R>(lhs.derived(), rhs.derived());
+}
+
+template<typename L, typename R>
+MatrixDifference<L, R> operator-(const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs) {
+    return MatrixDifference<L, R>(lhs.derived(), rhs.derived());
+}
+
+template<typename E>
+MatrixScaled<E> operator*(double coeff, const MatrixExpression<E>& matrix) {
+    return MatrixScaled<E>(coeff, matrix.derived());
+}
+
+template<typename E>
+MatrixScaled<E> operator*(const MatrixExpression<E>& matrix, double coeff) {
+    return MatrixScaled<E>(coeff, matrix.derived());
+}
+
+template<typename E>
+MatrixScaled<E> operator-(const MatrixExpression<E>& matrix) {
+    return MatrixScaled<E>(-1.0, matrix.derived());
+}
+
+#endif //MATRIXEXPRESSION_HPP
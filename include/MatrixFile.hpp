@@ -0,0 +1,110 @@
+#ifndef MATRIXFILE_HPP
+#define MATRIXFILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "Matrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Binary matrix file (".lom"): a 64-byte header followed by the raw payload.
+//   offset  0  char[8]   magic "LOBJMAT" (NUL terminated)
+//   offset  8  uint32    format version (MATRIX_FILE_VERSION)
+//   offset 12  uint32    element type (1 = IEEE 754 double)
+//   offset 16  uint32    0x01020304 in the writer's byte order (endianness mark)
+//   offset 20  uint32    payload alignment in bytes (64)
+//   offset 24  uint64    row count
+//   offset 32  uint64    column count
+//   offset 40  uint64    payload offset from the start of the file (64)
+//   offset 48  (reserved, zero)
+//   offset 64  row-major elements, no padding between rows
+// Header fields and elements are stored in the writer's native byte order. loadMatrix() converts files
+// written on a machine of the other byte order; MappedMatrix cannot (it never copies) and throws for them.
+constexpr std::uint32_t MATRIX_FILE_VERSION = 1;
+
+void saveMatrix(const std::string& path, ConstMatrixView matrix);
+[[nodiscard]] Matrix loadMatrix(const std::string& path);     // One read of the payload straight into the Matrix
+
+// Read-only matrix backed by a memory-mapped matrix file. Opening only reads the header; pages of the
+// payload are loaded by the OS on first access and shared with other processes mapping the same file,
+// so startup cost no longer grows with the matrix size.
+// Converts implicitly to a ConstMatrixView, so it can be used wherever one is taken (operator*, gemm(),
+// views, explicit Matrix / SquareMatrix copies, ...). Views must not outlive the MappedMatrix.
+class MappedMatrix {
+private:
+    void* mapping{};
+    std::size_t mappingSize{};
+    MatrixSize size{};
+    const double* elements{};
+
+    void unmap() noexcept;
+
+public:
+    // Constructors
+    explicit MappedMatrix(const std::string& path);
+
+    // (Move & Copy) (Constructor & Assignment)
+    MappedMatrix(const MappedMatrix&) = delete;
+    MappedMatrix(MappedMatrix&& matrix) noexcept;
+    MappedMatrix& operator=(const MappedMatrix&) = delete;
+    MappedMatrix& operator=(MappedMatrix&& matrix) noexcept;
+
+    // Methods
+    [[nodiscard]] Matrix toMatrix() const;    // Owning copy
+
+    // Getters
+    [[nodiscard]] const MatrixSize& getDimension() const;
+    [[nodiscard]] double element(std::size_t i, std::size_t j) const { return elements[i * size.columnCount + j]; }   // Unchecked
+    [[nodiscard]] ConstMatrixView view() const;
+
+    // Class Operators
+    operator ConstMatrixView() const;
+
+    // Destructor
+    ~MappedMatrix();
+};
+
+// Matrix kept in a matrix file and read / written a block at a time, for matrices larger than memory
+// (see OutOfCoreGemm.hpp). Every access goes to the file through the OS page cache; nothing is kept in
+// memory besides the header. One object must not be used by two threads at once; open the file twice
+// instead. Files of the other byte order are rejected.
+class DiskMatrix {
+private:
+    std::string path;
+    mutable std::fstream file{};
+    MatrixSize size{};
+    std::uint64_t payloadOffset{};
+    bool writable{true};
+
+    void checkBlock(std::size_t rowStart, std::size_t columnStart, const MatrixSize& blockSize) const;
+    [[nodiscard]] std::streamoff offset(std::size_t i, std::size_t j) const;
+
+public:
+    // Constructors
+    explicit DiskMatrix(const std::string& filePath);     // Existing file; read-only if it cannot be written
+    DiskMatrix(const std::string& filePath, std::size_t rowCount, std::size_t columnCount);   // New zero matrix (replaces the file)
+
+    // (Move & Copy) (Constructor & Assignment)
+    DiskMatrix(const DiskMatrix&) = delete;
+    DiskMatrix(DiskMatrix&& matrix) = default;
+    DiskMatrix& operator=(const DiskMatrix&) = delete;
+    DiskMatrix& operator=(DiskMatrix&& matrix) = default;
+
+    // Methods
+    // The block starting at (rowStart, columnStart) with the shape of the given view
+    void readBlock(std::size_t rowStart, std::size_t columnStart, MatrixView block) const;
+    void writeBlock(std::size_t rowStart, std::size_t columnStart, ConstMatrixView block);
+    [[nodiscard]] Matrix toMatrix() const;
+
+    // Getters
+    [[nodiscard]] const MatrixSize& getDimension() const;
+    [[nodiscard]] const std::string& getPath() const;
+
+    // Destructor
+    ~DiskMatrix() = default;
+};
+
+#endif //MATRIXFILE_HPP
@@ -0,0 +1,38 @@
+#ifndef MATRIXPOWERCACHE_HPP
+#define MATRIXPOWERCACHE_HPP
+
+#include <vector>
+
+#include "SquareMatrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Powers of one fixed SquareMatrix, for evaluating it at many exponents (e.g. a Markov transition
+// matrix at many horizons). The ladder A^1, A^2, A^4, ... A^(2^k) is extended on demand and kept,
+// so each query costs one product per set bit of the exponent beyond the first and squarings only
+// for bits never seen before. The matrix is copied in; later changes to the original are not seen.
+// Not thread-safe: queries may extend the ladder.
+class MatrixPowerCache {
+private:
+    std::vector<SquareMatrix> ladder{};   // ladder[k] = A^(2^k)
+    SquareMatrix scratch;
+
+    void extendTo(std::size_t level);
+
+public:
+    // Constructors
+    explicit MatrixPowerCache(const SquareMatrix& matrix);
+
+    // Methods
+    [[nodiscard]] SquareMatrix power(std::size_t exponent);
+    void power(std::size_t exponent, SquareMatrix& result);   // Reuses result's storage when it is n x n
+
+    // Getters
+    [[nodiscard]] const SquareMatrix& getMatrix() const;
+    [[nodiscard]] std::size_t getCachedLevels() const;
+
+    // Destructor
+    ~MatrixPowerCache() = default;
+};
+
+#endif //MATRIXPOWERCACHE_HPP
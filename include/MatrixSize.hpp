@@ -0,0 +1,16 @@
+#ifndef MATRIXSIZE_HPP
+#define MATRIXSIZE_HPP
+
+#include <cstddef>
+
+class MatrixSize {
+public:
+    std::size_t rowCount{};
+    std::size_t columnCount{};
+
+    MatrixSize() = default;
+    [[nodiscard]] bool validate() const;
+    ~MatrixSize() = default;
+};
+
+#endif //MATRIXSIZE_HPP
@@ -0,0 +1,34 @@
+#ifndef MATRIXTEXT_HPP
+#define MATRIXTEXT_HPP
+
+#include <string>
+
+#include "Matrix.hpp"
+#include "SparseMatrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Text import / export for exchanging matrices with other tools: CSV and Matrix Market
+// (https://math.nist.gov/MatrixMarket/formats.html).
+// Numbers are written with std::to_chars in shortest round-trip form (reading a file back gives the
+// exact same doubles) and read with std::from_chars, so neither depends on the locale.
+// Files are streamed in large chunks cut at line boundaries; big chunks are formatted / parsed in pieces
+// on the thread pool, and the pieces are stitched back in file order, so the result never depends on
+// the thread count.
+// Malformed input throws std::invalid_argument; files that cannot be opened, read or written throw
+// std::runtime_error.
+
+// One row per line, fields separated by delimiter. Blank lines are skipped; skipHeader drops the
+// first line (column names). Every row must have the same number of fields.
+void saveCsv(const std::string& path, ConstMatrixView matrix, char delimiter = ',');
+[[nodiscard]] Matrix loadCsv(const std::string& path, char delimiter = ',', bool skipHeader = false);
+
+// Dense matrices are written in "array" format (values column by column), sparse ones in "coordinate"
+// format (one-based "row column value" lines). Both loaders accept either format with real, integer or
+// pattern (all ones) values and general, symmetric or skew-symmetric layout; complex files are rejected.
+void saveMatrixMarket(const std::string& path, ConstMatrixView matrix);
+void saveMatrixMarket(const std::string& path, const SparseMatrix& matrix);
+[[nodiscard]] Matrix loadMatrixMarket(const std::string& path);
+[[nodiscard]] SparseMatrix loadSparseMatrixMarket(const std::string& path);
+
+#endif //MATRIXTEXT_HPP
@@ -0,0 +1,231 @@
+#ifndef MATRIXVIEW_HPP
+#define MATRIXVIEW_HPP
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "MatrixExpression.hpp"
+#include "MatrixSize.hpp"
+#include "Span.hpp"
+#include "VectorView.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+template<typename T>
+class BasicMatrixView;
+
+// Whether the spans [first1, first1 + span1) and [first2, first2 + span2) intersect, e.g. the extents of
+// two strided ranges. Pointers into unrelated buffers compare with std::less, so they never overlap.
+template<typename T>
+bool overlaps(const T* first1, std::size_t span1, const T* first2, std::size_t span2) {
+    std::less<const T*> before;
+    return before(first1, first2 + span2) && before(first2, first1 + span1);
+}
+
+// Whether two blocks share any element's address (conservatively: their extents intersect).
+template<typename T>
+bool overlaps(BasicMatrixView<const T> x, BasicMatrixView<const T> y) {
+    if(x.getDimension().rowCount == 0 || x.getDimension().columnCount == 0 ||
+       y.getDimension().rowCount == 0 || y.getDimension().columnCount == 0)
+        return false;
+    return overlaps(x.data(), x.getExtent(), y.data(), y.getExtent());
+}
+
+// Whether writing expr element by element into target could overwrite an element before it is read: an
+// operand overlaps target without viewing its elements at the same positions (a transposed or shifted
+// block of the same storage). Assignments evaluate such expressions into a temporary first.
+template<typename V, typename E>
+bool overlapsUnsafely(const V& target, const E& expr) {
+    using Scalar = typename E::Scalar;
+    BasicMatrixView<const Scalar> destination = target;
+    bool unsafe = false;
+    forEachOperand(expr, [&](const auto& operand) {
+        BasicMatrixView<const Scalar> source = operand;
+        if(overlaps(source, destination) &&
+           (source.data() != destination.data() || source.getStride() != destination.getStride() ||
+            source.getColumnStride() != destination.getColumnStride()))
+            unsafe = true;
+    });
+    return unsafe;
+}
+
+// Non-owning window onto a block of a Matrix (or of any buffer): element (i, j) lives at
+// data()[i * getStride() + j * getColumnStride()]. Views of a Matrix are row-major (column stride 1);
+// transposed() swaps the extents and the two strides, so a transposed view costs O(1) and is consumed
+// natively (like a BLAS trans argument) by operator*, gemm(), the lazy arithmetic and the row / column
+// getters. Only Matrix(view) copies it into row-major storage. Slicing a view (rows, columns, sub-blocks)
+// never copies, and views can be passed wherever a ConstMatrixView / MatrixView is taken.
+// The same lifetime rules as for BasicVectorView apply: a view must not outlive (or survive a
+// reallocation of) its owner. The destination of an assignment may appear anywhere in the expression;
+// when it appears at other positions (A = A.transposed()) the expression is evaluated into a temporary.
+template<typename T>
+class BasicMatrixView : public MatrixExpression<BasicMatrixView<T>> {
+private:
+    T* first{};
+    MatrixSize size{};
+    std::size_t stride{};   // Distance (in elements) between the starts of two consecutive rows
+    std::size_t step{};     // Distance (in elements) between two consecutive elements of a row
+
+    void checkDimension(const MatrixSize& exprSize) const {
+        if(exprSize.rowCount != size.rowCount || exprSize.columnCount != size.columnCount)
+            throw std::invalid_argument("Matrix should be " + std::to_string(size.rowCount) + "x" +
+                                        std::to_string(size.columnCount));
+    }
+
+    [[nodiscard]] T* rowPointer(std::size_t idx) const { return first + idx * stride; }
+
+    // apply(element, value) for every element and the matching value of expr, which is read in full
+    // first when it overlaps this view unsafely (see overlapsUnsafely()).
+    template<typename E, typename Apply>
+    void update(const E& expr, const Apply& apply) {
+        static_assert(std::is_same_v<Scalar, typename E::Scalar>, "Operands of different element types");
+        checkDimension(expr.getDimension());
+        if(overlapsUnsafely(*this, expr)) {
+            std::vector<Scalar> values;
+            values.reserve(size.rowCount * size.columnCount);
+            for(std::size_t i = 0; i < size.rowCount; i++)
+                for(std::size_t j = 0; j < size.columnCount; j++)
+                    values.push_back(expr.element(i, j));
+            for(std::size_t i = 0; i < size.rowCount; i++) {
+                T* row = rowPointer(i);
+                for(std::size_t j = 0; j < size.columnCount; j++)
+                    apply(row[j * step], values[i * size.columnCount + j]);
+            }
+            return;
+        }
+        for(std::size_t i = 0; i < size.rowCount; i++) {
+            T* row = rowPointer(i);
+            for(std::size_t j = 0; j < size.columnCount; j++)
+                apply(row[j * step], expr.element(i, j));
+        }
+    }
+
+public:
+    using Scalar = std::remove_const_t<T>;
+
+    // Constructors
+    BasicMatrixView(T* start, std::size_t rowCount, std::size_t columnCount, std::size_t rowStride,
+                    std::size_t elementStride = 1)
+        : MatrixExpression<BasicMatrixView<T>>(), first(start), size(), stride(rowStride), step(elementStride) {
+        size.rowCount = rowCount;
+        size.columnCount = columnCount;
+    }
+    BasicMatrixView(const BasicMatrixView& view) = default;
+
+    // Assignment copies elements (not the handle)
+    BasicMatrixView& operator=(const BasicMatrixView& view) {
+        return *this = static_cast<const MatrixExpression<BasicMatrixView>&>(view);
+    }
+
+    template<typename E>
+    BasicMatrixView& operator=(const MatrixExpression<E>& expr) {
+        update(expr.derived(), [](T& element, Scalar value) { element = value; });
+        return *this;
+    }
+
+    // Compound Assignment
+    template<typename E>
+    BasicMatrixView& operator+=(const MatrixExpression<E>& expr) {
+        update(expr.derived(), [](T& element, Scalar value) { element += value; });
+        return *this;
+    }
+
+    template<typename E>
+    BasicMatrixView& operator-=(const MatrixExpression<E>& expr) {
+        update(expr.derived(), [](T& element, Scalar value) { element -= value; });
+        return *this;
+    }
+
+    BasicMatrixView& operator*=(double coeff) {
+        for(std::size_t i = 0; i < size.rowCount; i++) {
+            T* row = rowPointer(i);
+            for(std::size_t j = 0; j < size.columnCount; j++)
+                row[j * step] = roundToScalar<Scalar>(coeff * row[j * step]);
+        }
+        return *this;
+    }
+
+    // Methods
+    [[nodiscard]] BasicVectorView<T> row(std::size_t idx) const {
+        if(idx >= size.rowCount)
+            throw std::invalid_argument("Index out of bound");
+        return BasicVectorView<T>(rowPointer(idx), size.columnCount, step);
+    }
+
+    [[nodiscard]] BasicVectorView<T> column(std::size_t idx) const {
+        if(idx >= size.columnCount)
+            throw std::invalid_argument("Index out of bound");
+        return BasicVectorView<T>(first + idx * step, size.rowCount, stride);
+    }
+
+    [[nodiscard]] Span<T> rowSpan(std::size_t idx) const {     // Row idx as a contiguous range (row-major views only)
+        checkIndexByPolicy(idx, size.rowCount);
+        if(step != 1)
+            throw std::invalid_argument("Rows of a transposed view are not contiguous");
+        return Span<T>(rowPointer(idx), size.columnCount);
+    }
+
+    // Rows rowStart ... rowEnd and columns columnStart ... columnEnd (inclusive, like getSubMatrix())
+    [[nodiscard]] BasicMatrixView subMatrix(std::size_t rowStart, std::size_t rowEnd,
+                                            std::size_t columnStart, std::size_t columnEnd) const {
+        if(rowEnd < rowStart || rowEnd >= size.rowCount)
+            throw std::invalid_argument("Condition didn't match (rowStart <= rowEnd < rowCount)");
+        if(columnEnd < columnStart || columnEnd >= size.columnCount)
+            throw std::invalid_argument("Condition didn't match (columnStart <= columnEnd < columnCount)");
+        return BasicMatrixView(rowPointer(rowStart) + columnStart * step, rowEnd - rowStart + 1,
+                               columnEnd - columnStart + 1, stride, step);
+    }
+
+    // Element (i, j) of the result is element (j, i) of this view; no element is touched. Assigning it to the
+    // block it views goes through a temporary (Matrix::transposeInPlace() does not need one).
+    [[nodiscard]] BasicMatrixView transposed() const {
+        return BasicMatrixView(first, size.columnCount, size.rowCount, step, stride);
+    }
+
+    // Getters
+    [[nodiscard]] const MatrixSize& getDimension() const { return size; }
+    [[nodiscard]] std::size_t getStride() const { return stride; }
+    [[nodiscard]] std::size_t getColumnStride() const { return step; }
+    [[nodiscard]] bool isRowMajor() const { return step == 1; }     // Contiguous rows: false for transposed views
+    [[nodiscard]] std::size_t getExtent() const {     // Elements from data() to one past the last element
+        return (size.rowCount - 1) * stride + (size.columnCount - 1) * step + 1;
+    }
+    [[nodiscard]] T* data() const { return first; }
+    [[nodiscard]] Scalar element(std::size_t i, std::size_t j) const { return first[i * stride + j * step]; }   // Unchecked
+
+    // Friend Operators
+    friend std::ostream& operator<<(std::ostream& os, const BasicMatrixView& view) {
+        for(std::size_t i = 0; i < view.size.rowCount; i++)
+            os << view.row(i);
+        return os;
+    }
+
+    // Class Operators
+    BasicVectorView<T> operator[](std::size_t idx) const {    // Checked by policy (see BoundsCheck.hpp)
+        checkIndexByPolicy(idx, size.rowCount);
+        return BasicVectorView<T>(rowPointer(idx), size.columnCount, step);
+    }
+
+    operator BasicMatrixView<const T>() const {
+        return BasicMatrixView<const T>(first, size.rowCount, size.columnCount, stride, step);
+    }
+
+    // Destructor
+    ~BasicMatrixView() = default;
+};
+
+using MatrixView = BasicMatrixView<double>;
+using ConstMatrixView = BasicMatrixView<const double>;
+
+template<typename E>
+inline constexpr bool isMatrixView = false;
+
+template<typename T>
+inline constexpr bool isMatrixView<BasicMatrixView<T>> = true;
+
+#endif //MATRIXVIEW_HPP
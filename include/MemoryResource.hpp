@@ -0,0 +1,89 @@
+#ifndef MEMORYRESOURCE_HPP
+#define MEMORYRESOURCE_HPP
+
+#include <cstddef>
+#include <memory_resource>
+
+// Where the element buffers of Vector, Matrix and the other containers come from.
+// Every buffer is requested through AlignedAllocator (AlignedAllocator.hpp) from a std::pmr::memory_resource,
+// always 64-byte aligned. Unless told otherwise, a new buffer uses the calling thread's current resource:
+// the innermost ScopedMemoryResource / ScopedArena alive on that thread, or else the process-wide default
+// (the aligned heap, or whatever setDefaultMemoryResource() installed).
+// A container keeps the resource it was created with. Moves steal the buffer (and its resource);
+// copies, and assignments between containers on different resources, copy the elements into the
+// destination's own resource.
+
+// operator new / delete with 64-byte alignment. Counted in AllocationStats::heapAllocations.
+[[nodiscard]] std::pmr::memory_resource* alignedHeapResource();
+
+// Process-wide thread-safe pool (std::pmr::synchronized_pool_resource) over the aligned heap:
+// freed buffers are kept and reused, mostly without touching the global heap or a shared lock.
+[[nodiscard]] std::pmr::memory_resource* pooledResource();
+
+// nullptr restores the aligned heap. The resource must outlive every buffer allocated from it.
+void setDefaultMemoryResource(std::pmr::memory_resource* resource);
+[[nodiscard]] std::pmr::memory_resource* defaultMemoryResource();
+[[nodiscard]] std::pmr::memory_resource* currentMemoryResource();     // Of the calling thread
+
+// Makes resource the calling thread's current one until the end of the scope.
+class ScopedMemoryResource {
+private:
+    std::pmr::memory_resource* previous;
+
+public:
+    // Constructors
+    explicit ScopedMemoryResource(std::pmr::memory_resource* resource);
+
+    // (Move & Copy) (Constructor & Assignment)
+    ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+    ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+
+    // Destructor
+    ~ScopedMemoryResource();
+};
+
+// Monotonic arena for the temporaries of one computation on the calling thread: every buffer allocated
+// inside the scope is carved out of a few large chunks, frees are no-ops, and everything is returned
+// to the heap at once when the scope ends.
+// Nothing allocated inside the scope may outlive it. Copy results out instead of moving them: a copy made
+// after the scope (Matrix kept(result);) lands on the default resource. Tasks that other threads of the
+// pool run are not affected.
+class ScopedArena {
+private:
+    std::pmr::monotonic_buffer_resource arena;
+    ScopedMemoryResource scope;
+
+public:
+    // Constructors
+    explicit ScopedArena(std::size_t initialSize = 1 << 20);   // Bytes of the first chunk; later ones grow
+
+    // (Move & Copy) (Constructor & Assignment)
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    // Getters
+    [[nodiscard]] std::pmr::memory_resource* getResource();
+
+    // Destructor
+    ~ScopedArena() = default;
+};
+
+// Process-wide totals of per-thread counters: each thread counts its own allocations (no shared cache
+// line on the allocation path) and allocationStats() sums them. Failed allocations are not counted.
+struct AllocationStats {
+    std::size_t allocations{};       // Buffers handed out through AlignedAllocator (any resource)
+    std::size_t deallocations{};
+    std::size_t bytesAllocated{};
+    std::size_t heapAllocations{};   // Calls that reached operator new through alignedHeapResource()
+    std::size_t heapBytes{};
+};
+
+[[nodiscard]] AllocationStats allocationStats();
+void resetAllocationStats();
+[[nodiscard]] std::size_t threadBytesAllocated() noexcept;   // Running total of bytesAllocated on the calling thread, never reset
+
+// Called by AlignedAllocator
+void recordAllocation(std::size_t bytes) noexcept;
+void recordDeallocation() noexcept;
+
+#endif //MEMORYRESOURCE_HPP
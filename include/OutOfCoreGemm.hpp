@@ -0,0 +1,21 @@
+#ifndef OUTOFCOREGEMM_HPP
+#define OUTOFCOREGEMM_HPP
+
+#include <cstddef>
+
+#include "MatrixFile.hpp"
+
+// C = A * B for matrices kept on disk (DiskMatrix), using at most about memoryBudget bytes of memory.
+// C is computed one square tile at a time; for every tile, the matching row of A tiles and column of
+// B tiles are streamed from the files and accumulated with the in-memory kernel (gemm(), on the thread
+// pool). Reads are double buffered: the tiles of the next step load on a background thread while the
+// current one is multiplied, and every finished C tile is written back on another background thread
+// while the next one is computed.
+// The tile size follows from the budget (six tiles in flight: two of A, two of B, two of C), rounded
+// down to a multiple of the kernel's depth blocking (256) and never below it; with that, every C element
+// is summed in the same order as by operator*, and the result is identical to the in-memory product.
+// c must already have A's row count and B's column count, and must be a different file from a and b.
+void outOfCoreMultiply(const DiskMatrix& a, const DiskMatrix& b, DiskMatrix& c,
+                       std::size_t memoryBudget = std::size_t(512) << 20);
+
+#endif //OUTOFCOREGEMM_HPP
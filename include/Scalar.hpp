@@ -0,0 +1,64 @@
+#ifndef SCALAR_HPP
+#define SCALAR_HPP
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Element types of BasicVector and BasicMatrix. Vector and Matrix (double) are the full-featured ones:
+// SquareMatrix, the decompositions, the sparse / symmetric / fixed-size types and the file formats build
+// on them. float and int get the owning containers, views, lazy arithmetic, dot products and products.
+// Converting between element types is always explicit: FloatMatrix f(m); Matrix m2(f);
+// int scaling (coefficients, +=, -=) rounds to nearest and range-checks like the int gemm(), see roundToScalar().
+template<typename T>
+class BasicVector;
+template<typename T>
+class BasicMatrix;
+
+using Vector = BasicVector<double>;
+using FloatVector = BasicVector<float>;
+using IntVector = BasicVector<int>;
+using Matrix = BasicMatrix<double>;
+using FloatMatrix = BasicMatrix<float>;
+using IntMatrix = BasicMatrix<int>;
+
+// Type sums of products are carried in. float elements are accumulated in double (mixed precision: half
+// the memory traffic of double, without float's rounding error growing with the length), int in long long.
+template<typename T>
+struct ScalarTraits;
+
+template<>
+struct ScalarTraits<double> {
+    using Accumulator = double;
+};
+
+template<>
+struct ScalarTraits<float> {
+    using Accumulator = double;
+};
+
+template<>
+struct ScalarTraits<int> {
+    using Accumulator = long long;
+};
+
+template<typename T>
+using Accumulator = typename ScalarTraits<T>::Accumulator;
+
+// A double result (coefficient * element, element + sign * element, ...) stored as T. int elements are
+// rounded to nearest and throw std::overflow_error when the result does not fit, as in the int gemm().
+template<typename T>
+T roundToScalar(double value) {
+    if constexpr(std::is_integral_v<T>) {
+        double rounded = std::round(value);
+        if(!(rounded >= static_cast<double>(std::numeric_limits<T>::min()) &&
+             rounded <= static_cast<double>(std::numeric_limits<T>::max())))
+            throw std::overflow_error("Element does not fit in an int");
+        return static_cast<T>(rounded);
+    } else {
+        return static_cast<T>(value);
+    }
+}
+
+#endif //SCALAR_HPP
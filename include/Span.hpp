@@ -0,0 +1,55 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include "BoundsCheck.hpp"
+#include "VectorView.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Contiguous, non-owning range of elements (the C++17 stand-in for std::span): a whole Vector or one
+// row of a Matrix / MatrixView. Iterators are plain pointers and operator[] does not check, so loops
+// over a Span vectorize like loops over a raw array. Same lifetime rules as the views (see VectorView.hpp).
+template<typename T>
+class Span {
+private:
+    T* first{};
+    std::size_t n{};
+
+public:
+    // Constructors
+    constexpr Span() = default;
+    constexpr Span(T* start, std::size_t length) : first(start), n(length) {}
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& span) : first(span.data()), n(span.size()) {}     // Span<double> to Span<const double>
+
+    // Methods
+    [[nodiscard]] constexpr Span subspan(std::size_t offset, std::size_t count) const {
+        if(offset > n || count > n - offset)
+            throw std::invalid_argument("Condition didn't match (offset + count <= size)");
+        return Span(first + offset, count);
+    }
+    [[nodiscard]] constexpr T& at(std::size_t idx) const {
+        checkIndex(idx, n);
+        return first[idx];
+    }
+
+    // Getters
+    [[nodiscard]] constexpr std::size_t size() const { return n; }
+    [[nodiscard]] constexpr bool empty() const { return n == 0; }
+    [[nodiscard]] constexpr T* data() const { return first; }
+    [[nodiscard]] constexpr T* begin() const { return first; }
+    [[nodiscard]] constexpr T* end() const { return first + n; }
+
+    // Class Operators
+    constexpr T& operator[](std::size_t idx) const { return first[idx]; }     // Unchecked
+    template<typename U, typename = std::enable_if_t<std::is_convertible_v<T (*)[], U (*)[]>>>
+    constexpr operator BasicVectorView<U>() const { return BasicVectorView<U>(first, n); }    // VectorView / ConstVectorView
+
+    // Destructor
+    ~Span() = default;
+};
+
+#endif //SPAN_HPP
@@ -0,0 +1,83 @@
+#ifndef SPARSEMATRIX_HPP
+#define SPARSEMATRIX_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Matrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// One entry of a matrix in coordinate (COO) form
+struct Triplet {
+    std::size_t row{};
+    std::size_t column{};
+    double value{};
+};
+
+// Sparse matrix in compressed sparse row (CSR) form: only stored entries take memory (an index and a
+// value each, plus one offset per row), so a 100k x 100k matrix with a few nonzeros per row fits in a
+// few megabytes. Columns are sorted within each row.
+// Products with dense vectors (SpMV) and matrices (SpMM) run on the thread pool, split into row ranges
+// of about equal nonzero counts; each output element is computed by one thread in a fixed order, so
+// results do not depend on the thread count.
+class SparseMatrix {
+private:
+    MatrixSize size{};
+    std::vector<std::size_t> rowStart{};      // Row i's entries are [rowStart[i], rowStart[i + 1])
+    std::vector<std::size_t> columnIndex{};
+    std::vector<double> values{};
+
+    // lhs + sign * rhs, for operands of the same size
+    static SparseMatrix merge(const SparseMatrix& lhs, const SparseMatrix& rhs, double sign);
+
+public:
+    // Constructors
+    SparseMatrix(std::size_t rowCount, std::size_t columnCount);   // Zero matrix
+    // Duplicate (row, column) pairs are summed
+    SparseMatrix(std::size_t rowCount, std::size_t columnCount, const std::vector<Triplet>& triplets);
+    explicit SparseMatrix(ConstMatrixView matrix);   // Keeps the nonzero elements
+
+    // (Move & Copy) (Constructor & Assignment)
+    SparseMatrix(const SparseMatrix& matrix) = default;
+    SparseMatrix(SparseMatrix&& matrix) = default;
+    SparseMatrix& operator=(const SparseMatrix& matrix) = default;
+    SparseMatrix& operator=(SparseMatrix&& matrix) = default;
+
+    // Compound Assignment
+    SparseMatrix& operator+=(const SparseMatrix& rhs);
+    SparseMatrix& operator-=(const SparseMatrix& rhs);
+    SparseMatrix& operator*=(double coeff);
+
+    // Methods
+    [[nodiscard]] std::string toString() const;
+    SparseMatrix& transpose();
+    void multiply(ConstVectorView vec, VectorView result) const;          // result = this * vec (SpMV)
+    void multiply(ConstMatrixView matrix, MatrixView result) const;       // result = this * matrix (SpMM)
+    [[nodiscard]] Matrix toMatrix() const;
+    [[nodiscard]] std::vector<Triplet> toTriplets() const;
+
+    // Getters
+    [[nodiscard]] const MatrixSize& getDimension() const;
+    [[nodiscard]] std::size_t getNonZeroCount() const;
+    [[nodiscard]] double getElement(std::size_t i, std::size_t j) const;   // Binary search in row i
+    [[nodiscard]] const std::vector<std::size_t>& getRowStarts() const;
+    [[nodiscard]] const std::vector<std::size_t>& getColumnIndices() const;
+    [[nodiscard]] const std::vector<double>& getValues() const;
+
+    // Friend Operators
+    friend std::ostream& operator<<(std::ostream& os, const SparseMatrix& matrix);   // One "(i, j): value" per entry
+    friend SparseMatrix operator+(const SparseMatrix& lhs, const SparseMatrix& rhs);
+    friend SparseMatrix operator-(const SparseMatrix& lhs, const SparseMatrix& rhs);
+    friend SparseMatrix operator*(double coeff, const SparseMatrix& matrix);
+    friend SparseMatrix operator*(const SparseMatrix& matrix, double coeff);
+    friend Vector operator*(const SparseMatrix& lhs, ConstVectorView rhs);
+    friend Matrix operator*(const SparseMatrix& lhs, ConstMatrixView rhs);
+
+    // Destructor
+    ~SparseMatrix() = default;
+};
+
+#endif //SPARSEMATRIX_HPP
@@ -2,12 +2,15 @@
 #define SQUAREMATRIX_HPP
 
 #include <initializer_list>
+#include <type_traits>
 #include <vector>
 
 #include "Matrix.hpp"
 
 // Note: All Objects Are Zero-Origin Based !
 
+class LUDecomposition;
+
 class SquareMatrix: public Matrix {
 public:
     // Constructors
@@ -16,19 +19,41 @@ public:
     explicit SquareMatrix(const std::vector<Vector>& matrixRows);
     explicit SquareMatrix(const std::vector<std::vector<double>>& matrixRows);
     explicit SquareMatrix(const Matrix& matrix);
+    template<typename E, typename = std::enable_if_t<!std::is_base_of_v<Matrix, E> && !isMatrixView<E>>>
+    SquareMatrix(const MatrixExpression<E>& expr);   // Lazy expressions of square matrices
+    explicit SquareMatrix(ConstMatrixView view);
 
     // (Move & Copy) (Constructor & Assignment)
     SquareMatrix(const SquareMatrix& matrix);
-    SquareMatrix(const SquareMatrix&& matrix) noexcept;
+    SquareMatrix(SquareMatrix&& matrix) noexcept;
     SquareMatrix& operator=(const SquareMatrix& matrix);
-    SquareMatrix& operator=(SquareMatrix&& matrix) noexcept;
+    SquareMatrix& operator=(SquareMatrix&& matrix);
+    template<typename E, typename = std::enable_if_t<!std::is_base_of_v<Matrix, E>>>
+    SquareMatrix& operator=(const MatrixExpression<E>& expr);
+    template<typename E>
+    SquareMatrix& assign(ExecutionPolicy policy, const MatrixExpression<E>& expr);
+
+    // Compound Assignment (in place, never allocates)
+    template<typename E>
+    SquareMatrix& operator+=(const MatrixExpression<E>& expr);
+    template<typename E>
+    SquareMatrix& operator-=(const MatrixExpression<E>& expr);
+    SquareMatrix& operator*=(double coeff);
 
     // Methods
+    [[nodiscard]] static SquareMatrix identity(std::size_t n);
     SquareMatrix& transpose() override;
     SquareMatrix& swapRows(std::size_t idx1, std::size_t idx2) override;
     SquareMatrix& swapColumns(std::size_t idx1, std::size_t idx2) override;
+    // The four below factor the matrix on every call; factor once with lu() to solve many systems
+    [[nodiscard]] LUDecomposition lu() const;            // See LUDecomposition.hpp
+    [[nodiscard]] double determinant() const;
+    [[nodiscard]] SquareMatrix inverse() const;          // Throws if the matrix is singular
+    [[nodiscard]] Vector solve(ConstVectorView rhs) const;    // x with this * x = rhs
+    [[nodiscard]] Matrix solve(ConstMatrixView rhs) const;    // X with this * X = rhs, one column per system
 
     // Setters
+    using Matrix::setColumn;    // (ExecutionPolicy overload)
     SquareMatrix& setRow(std::size_t idx, const Vector& row) override;
     SquareMatrix& setColumn(std::size_t idx, const Vector& column) override;
     SquareMatrix& setSubRow(std::size_t idx, std::size_t columnStart, const Vector &subRow) override;
@@ -37,12 +62,47 @@ public:
     // Friend Operators
     friend SquareMatrix operator*(const SquareMatrix& lhs, const SquareMatrix& rhs);
     friend SquareMatrix operator^(const SquareMatrix& matrix, std::size_t power);
-    friend SquareMatrix operator*(const SquareMatrix& lhs, double coeff);
-    friend SquareMatrix operator*(double coeff, const SquareMatrix& lhs);
-    friend SquareMatrix operator+(const SquareMatrix& lhs, const SquareMatrix& rhs);
+    // Always Strassen-Winograd (see Strassen.hpp); operator* only picks it above strassenThreshold()
+    friend SquareMatrix strassenMultiply(const SquareMatrix& lhs, const SquareMatrix& rhs);
 
     // Destructor
     ~SquareMatrix() override = default;
 };
 
+template<typename E, typename>
+SquareMatrix::SquareMatrix(const MatrixExpression<E>& expr) : Matrix(expr) {
+    if(size.rowCount != size.columnCount)
+        throw std::invalid_argument("This is not Square Matrix!");
+}
+
+template<typename E, typename>
+SquareMatrix& SquareMatrix::operator=(const MatrixExpression<E>& expr) {
+    const MatrixSize& exprSize = expr.derived().getDimension();
+    if(exprSize.rowCount != exprSize.columnCount)
+        throw std::invalid_argument("This is not Square Matrix!");
+    Matrix::operator=(expr);
+    return *this;
+}
+
+template<typename E>
+SquareMatrix& SquareMatrix::assign(ExecutionPolicy policy, const MatrixExpression<E>& expr) {
+    const MatrixSize& exprSize = expr.derived().getDimension();
+    if(exprSize.rowCount != exprSize.columnCount)
+        throw std::invalid_argument("This is not Square Matrix!");
+    Matrix::assign(policy, expr);
+    return *this;
+}
+
+template<typename E>
+SquareMatrix& SquareMatrix::operator+=(const MatrixExpression<E>& expr) {
+    Matrix::operator+=(expr);
+    return *this;
+}
+
+template<typename E>
+SquareMatrix& SquareMatrix::operator-=(const MatrixExpression<E>& expr) {
+    Matrix::operator-=(expr);
+    return *this;
+}
+
 #endif //SQUAREMATRIX_HPP
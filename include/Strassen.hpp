@@ -0,0 +1,34 @@
+#ifndef STRASSEN_HPP
+#define STRASSEN_HPP
+
+#include <cstddef>
+
+// Strassen-Winograd multiplication of square row-major blocks: 7 half-size products and 15 block
+// additions per level instead of 8 products, so roughly n^2.81 flops. Recursion stops at `cutoff`
+// and hands the leaves to blockedGemm(), which still runs on the thread pool.
+// Odd sizes are handled by dynamic peeling: the even (n-1) x (n-1) part recurses and the last row
+// and column are fixed up with thin blockedGemm() calls, so no padding copies are made.
+// All temporaries live in one per-thread workspace (about 2n^2/3 doubles), sized once per call and
+// carved up level by level, so the recursion itself never allocates.
+//
+// Error bound: with l = number of recursion levels and n0 = n / 2^l the leaf size, the computed
+// product satisfies (Higham, Accuracy and Stability of Numerical Algorithms, sec. 23.2.2)
+//     max|C - fl(C)| <= [ (n0^2 + 6 n0) 18^l - 6n ] u max|A| max|B| + O(u^2),
+// where u = 2^-53, compared with the componentwise bound |C - fl(C)| <= n u |A||B| of the classical
+// kernel. Each level multiplies the worst-case constant by ~18 / 4 relative to the classical one,
+// so keep the number of levels small (a cutoff of 128-512); in practice the observed error is
+// one to two orders of magnitude below the bound.
+
+// Process-wide settings read by operator*(const SquareMatrix&, const SquareMatrix&), safe to change while
+// other threads multiply. Opt-in: the default threshold of 0 keeps the classical kernel (and its bitwise
+// reproducibility).
+void setStrassenThreshold(std::size_t threshold);   // Strassen for n >= threshold; 0 = never
+[[nodiscard]] std::size_t strassenThreshold();
+void setStrassenCutoff(std::size_t cutoff);         // Blocks of this size or smaller go to blockedGemm(); default 256
+[[nodiscard]] std::size_t strassenCutoff();
+
+// C = A * B for n x n blocks with row strides lda, ldb and ldc. C must not overlap A or B.
+void strassenGemm(std::size_t n, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+                  double* c, std::size_t ldc, std::size_t cutoff);
+
+#endif //STRASSEN_HPP
@@ -0,0 +1,82 @@
+#ifndef SYMMETRICMATRIX_HPP
+#define SYMMETRICMATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "AlignedAllocator.hpp"
+#include "SquareMatrix.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+class CholeskyDecomposition;
+
+// Symmetric n x n matrix storing only its lower triangle: with T tiles per side, about (T + 1) / (2 T) of
+// n^2 doubles, so n^2 / 2 for large matrices (a 20000 x 20000 covariance matrix takes 1.6 GB instead of 3.2 GB).
+// The triangle is cut into square tiles stored one after the other, each row-major and contiguous;
+// tiles on the diagonal are kept whole (both of their triangles). Every tile is then an ordinary
+// strided block, so products and the Cholesky factorization run on the multiply kernel (Gemm.hpp).
+// Tiles have at most 64 rows, evenly shared (130 rows make 3 tiles of 44); matrices of at most 64 rows
+// are a single tile, i.e. stored in full.
+class SymmetricMatrix {
+private:
+    AlignedBuffer data{};      // Tile (I, J), J <= I, starts at ((I * (I + 1)) / 2 + J) * tileSize^2
+    std::size_t n{};
+    std::size_t tileSize{};
+    std::size_t tileCount{};
+
+    double* tile(std::size_t I, std::size_t J) { return data.data() + ((I * (I + 1)) / 2 + J) * tileSize * tileSize; }
+    [[nodiscard]] const double* tile(std::size_t I, std::size_t J) const {
+        return data.data() + ((I * (I + 1)) / 2 + J) * tileSize * tileSize;
+    }
+    [[nodiscard]] std::size_t tileExtent(std::size_t I) const { return std::min(tileSize, n - I * tileSize); }
+    [[nodiscard]] std::size_t offset(std::size_t i, std::size_t j) const;   // Of element (i, j), i >= j
+
+    friend class CholeskyDecomposition;
+
+public:
+    // Constructors
+    explicit SymmetricMatrix(std::size_t size);         // Zero matrix
+    explicit SymmetricMatrix(ConstMatrixView matrix);   // Reads the lower triangle only; the matrix must be square
+
+    // (Move & Copy) (Constructor & Assignment)
+    SymmetricMatrix(const SymmetricMatrix& matrix) = default;
+    SymmetricMatrix(SymmetricMatrix&& matrix) = default;
+    SymmetricMatrix& operator=(const SymmetricMatrix& matrix) = default;
+    SymmetricMatrix& operator=(SymmetricMatrix&& matrix) = default;
+
+    // Compound Assignment (in place, never allocates)
+    SymmetricMatrix& operator+=(const SymmetricMatrix& rhs);
+    SymmetricMatrix& operator-=(const SymmetricMatrix& rhs);
+    SymmetricMatrix& operator*=(double coeff);
+
+    // Methods
+    [[nodiscard]] std::string toString() const;
+    [[nodiscard]] SquareMatrix toSquareMatrix() const;
+    [[nodiscard]] CholeskyDecomposition cholesky() const;                 // See CholeskyDecomposition.hpp
+    void multiply(ConstVectorView vec, VectorView result) const;          // result = this * vec
+    void multiply(ConstMatrixView matrix, MatrixView result) const;       // result = this * matrix
+
+    // Getters
+    [[nodiscard]] std::size_t getDimension() const;
+    [[nodiscard]] double getElement(std::size_t i, std::size_t j) const;
+
+    // Setters
+    SymmetricMatrix& setElement(std::size_t i, std::size_t j, double value);   // Sets (i, j) and (j, i)
+
+    // Friend Operators
+    friend std::ostream& operator<<(std::ostream& os, const SymmetricMatrix& matrix);
+    friend SymmetricMatrix operator+(const SymmetricMatrix& lhs, const SymmetricMatrix& rhs);
+    friend SymmetricMatrix operator-(const SymmetricMatrix& lhs, const SymmetricMatrix& rhs);
+    friend SymmetricMatrix operator*(double coeff, const SymmetricMatrix& matrix);
+    friend SymmetricMatrix operator*(const SymmetricMatrix& matrix, double coeff);
+    friend Vector operator*(const SymmetricMatrix& lhs, ConstVectorView rhs);
+    friend Matrix operator*(const SymmetricMatrix& lhs, ConstMatrixView rhs);
+
+    // Destructor
+    ~SymmetricMatrix() = default;
+};
+
+#endif //SYMMETRICMATRIX_HPP
@@ -0,0 +1,78 @@
+#ifndef THREADPOOL_HPP
+#define THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Process-wide work-stealing pool used by the parallel kernels.
+// Each parallelFor() deals its task indices out to per-thread ranges; a thread works through its own
+// range from the front and, once empty, steals from the back of the others. The calling thread takes
+// part in the work, so a pool of N threads starts N - 1 workers. Dispatching a batch does not allocate.
+class ThreadPool {
+private:
+    struct WorkerQueue {
+        std::mutex mutex{};
+        std::size_t begin{};    // Next index to run
+        std::size_t end{};      // One past the last index still queued
+    };
+
+    // Non-owning reference to the callable passed to parallelFor()
+    struct TaskRef {
+        void (*invoke)(const void* task, std::size_t idx);
+        const void* task;
+    };
+
+    std::vector<std::thread> workers{};
+    std::vector<std::unique_ptr<WorkerQueue>> queues{};    // queues[0] belongs to the calling thread
+    TaskRef currentTask{};
+    std::exception_ptr failure{};
+    std::atomic<std::size_t> remaining{};
+    std::atomic<std::size_t> threadCount{};                // queues.size(), for getThreadCount()
+    std::size_t generation{};
+    bool stopping{};
+    std::mutex stateMutex{};
+    std::mutex batchMutex{};                               // One parallelFor() at a time
+    std::condition_variable wakeWorkers{};
+    std::condition_variable batchDone{};
+
+    explicit ThreadPool(std::size_t threadCount);
+    void startWorkers(std::size_t count);
+    void stopWorkers();
+    void workerLoop(std::size_t queueIdx);
+    void drain(std::size_t queueIdx);
+    bool popTask(std::size_t queueIdx, std::size_t& task);
+    void run(std::size_t taskCount, TaskRef task);
+
+public:
+    // The pool is created on first use and lives until the process exits.
+    static ThreadPool& instance();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Methods
+    // 0 selects std::thread::hardware_concurrency(); the LINEAROBJECTS_THREADS environment variable
+    // sets the initial value.
+    void setThreadCount(std::size_t threadCount);
+    [[nodiscard]] std::size_t getThreadCount() const;
+
+    // Runs task(0) ... task(taskCount - 1) and returns once all of them finished. The first exception
+    // thrown by a task is rethrown here. Calls made from inside a task run serially on that thread.
+    template<typename Task>
+    void parallelFor(std::size_t taskCount, const Task& task) {
+        run(taskCount, TaskRef{[](const void* callable, std::size_t idx) {
+            (*static_cast<const Task*>(callable))(idx);
+        }, &task});
+    }
+
+    // Destructor
+    ~ThreadPool();
+};
+
+#endif //THREADPOOL_HPP
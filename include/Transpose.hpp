@@ -0,0 +1,33 @@
+#ifndef TRANSPOSE_HPP
+#define TRANSPOSE_HPP
+
+#include <cstddef>
+
+// Layout kernels behind Matrix::transpose(), transposeInPlace() and rotate().
+// All buffers are row-major; "packed" means the row stride equals the column count.
+// Instantiated for double, float and int elements (see Scalar.hpp).
+
+// dst = src^T, where src is rowCount x columnCount. Cache-oblivious: the longer side is halved until
+// the block fits in L1, so reads and writes both stay within a few cache lines per step.
+template<typename T>
+void transposeOutOfPlace(std::size_t rowCount, std::size_t columnCount,
+                         const T* src, std::size_t srcStride, T* dst, std::size_t dstStride);
+
+// In-place transpose of an n x n block, tile by tile (a tile and its mirror are swapped together).
+template<typename T>
+void transposeSquareInPlace(std::size_t n, T* data, std::size_t stride);
+
+// In-place transpose of a packed rowCount x columnCount buffer (afterwards packed columnCount x rowCount).
+// Follows the permutation cycles, so the only extra memory is one bit per element.
+template<typename T>
+void transposeInPlace(std::size_t rowCount, std::size_t columnCount, T* data);
+
+// In-place 90 degree clockwise rotation: new(i, j) = old(rowCount - 1 - j, i).
+// Square blocks rotate four elements at a time in a single pass; packed rectangular buffers follow
+// the rotation's permutation cycles (one bit of extra memory per element).
+template<typename T>
+void rotateSquareInPlace(std::size_t n, T* data, std::size_t stride);
+template<typename T>
+void rotateInPlace(std::size_t rowCount, std::size_t columnCount, T* data);
+
+#endif //TRANSPOSE_HPP
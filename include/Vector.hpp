@@ -8,9 +8,18 @@
 #include <string>
 #include <numeric>
 #include <initializer_list>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-class Matrix;
+#include "AlignedAllocator.hpp"
+#include "BoundsCheck.hpp"
+#include "Execution.hpp"
+#include "Scalar.hpp"
+#include "Span.hpp"
+#include "VectorExpression.hpp"
+#include "VectorKernels.hpp"
+#include "VectorView.hpp"
 
 // Note: All Objects Are Zero-Origin Based !
 enum class VectorType {
@@ -18,46 +27,221 @@ enum class VectorType {
     ColumnMatrix
 };
 
-class Vector {
+// Owning vector of T (double, float or int; see Scalar.hpp for the Vector / FloatVector / IntVector aliases).
+template<typename T>
+class BasicVector : public VectorExpression<BasicVector<T>> {
 private:
-        std::vector<double> comps{};
+        BasicAlignedBuffer<T> comps{};
         std::size_t n{};
+
+        template<typename E>
+        void assign(const E& expr, std::size_t begin, std::size_t end);
+        template<typename E>
+        void accumulate(const E& expr, double sign);
+        [[nodiscard]] BasicVector cross(const BasicVector& rhs) const;
 public:
+    using Scalar = T;
 
     // Constructors
-    Vector(std::initializer_list<double> components);
-    explicit Vector(std::size_t size);
-    explicit Vector(const std::vector<double>& components);
+    BasicVector(std::initializer_list<T> components);
+    explicit BasicVector(std::size_t size);
+    BasicVector(std::size_t size, std::pmr::memory_resource* resource);   // Zero vector on resource (see MemoryResource.hpp)
+    explicit BasicVector(const std::vector<T>& components);        // Copies (the BasicAlignedBuffer one adopts)
+    explicit BasicVector(BasicAlignedBuffer<T>&& components) noexcept;   // Adopts the buffer, no copy
+    BasicVector(const T* first, const T* last);
+    explicit BasicVector(BasicVectorView<const T> view);   // Owning copy of a view (or of anything that converts to one)
+    template<typename E, typename = std::enable_if_t<std::is_same_v<typename E::Scalar, T>>>
+    BasicVector(const VectorExpression<E>& expr);   // Evaluates a lazy expression in a single pass
+    template<typename E, typename = std::enable_if_t<std::is_same_v<typename E::Scalar, T>>>
+    BasicVector(ExecutionPolicy policy, const VectorExpression<E>& expr);   // The same, split across threads
+    template<typename U, typename = std::enable_if_t<!std::is_same_v<U, T>>>
+    explicit BasicVector(const BasicVector<U>& vec);   // Element type conversion (static_cast of each element)
 
 
     // (Move & Copy) (Constructor & Assignment)
-    Vector(const Vector& vec);
-    Vector(const Vector&& vec) noexcept;
-    Vector& operator=(const Vector& rhs);
-    Vector& operator=(Vector&& rhs) noexcept;
+    BasicVector(const BasicVector& vec);
+    BasicVector(BasicVector&& vec) noexcept;
+    BasicVector& operator=(const BasicVector& rhs);
+    BasicVector& operator=(BasicVector&& rhs);   // Copies (and may throw) when the memory resources differ
+    template<typename E>
+    BasicVector& operator=(const VectorExpression<E>& expr);
+    template<typename E>
+    BasicVector& assign(ExecutionPolicy policy, const VectorExpression<E>& expr);   // operator=, see Execution.hpp
+
+    // Compound Assignment (in place, never allocates)
+    template<typename E>
+    BasicVector& operator+=(const VectorExpression<E>& expr);
+    template<typename E>
+    BasicVector& operator-=(const VectorExpression<E>& expr);
+    BasicVector& operator*=(double coeff);
 
     // Methods
     [[nodiscard]] std::string toString() const;
     [[nodiscard]] double magnitude() const;
-    [[nodiscard]] std::size_t getDimension() const;
-    [[nodiscard]] double angle(const Vector& rhs) const; // In Radians
-    [[nodiscard]] Matrix getMatrix(VectorType vType) const;
-
-    // Operators
-    friend std::ostream& operator<<(std::ostream& os, const Vector& vec);    // Printing vec.toString()
-    friend double operator*(const Vector& lhs, const Vector& rhs);  // Dot Product
-    friend Vector operator^(const Vector& lhs, const Vector& rhs); // Cross Product
-    friend Vector operator*(const Vector& vec, double coeff);   // Vector with Coefficient
-    friend Vector operator*(double coeff, const Vector& vec);   // Vector with Coefficient (vec * coeff)
-    friend Vector operator+(const Vector& lhs, const Vector& rhs); // Vector Addition
+    [[nodiscard]] double magnitude(ExecutionPolicy policy) const;
+    [[nodiscard]] Accumulator<T> dot(const BasicVector& rhs) const;  // Dot Product (also spelled lhs * rhs)
+    [[nodiscard]] Accumulator<T> dot(ExecutionPolicy policy, const BasicVector& rhs) const;
+    [[nodiscard]] std::size_t getDimension() const { return n; }
+    [[nodiscard]] std::pmr::memory_resource* getMemoryResource() const;
+    [[nodiscard]] double angle(const BasicVector& rhs) const; // In Radians
+    [[nodiscard]] BasicMatrix<T> getMatrix(VectorType vType) const;
+    [[nodiscard]] T element(std::size_t i) const { return comps[i]; }   // Unchecked read for expressions
+
+    // Element Access (operator[] checks by policy, at() always, the rest never; see BoundsCheck.hpp)
+    [[nodiscard]] T& at(std::size_t i) { checkIndex(i, n); return comps[i]; }
+    [[nodiscard]] const T& at(std::size_t i) const { checkIndex(i, n); return comps[i]; }
+    [[nodiscard]] T* data() { return comps.data(); }
+    [[nodiscard]] const T* data() const { return comps.data(); }
+    [[nodiscard]] T* begin() { return comps.data(); }
+    [[nodiscard]] T* end() { return comps.data() + n; }
+    [[nodiscard]] const T* begin() const { return comps.data(); }
+    [[nodiscard]] const T* end() const { return comps.data() + n; }
+    [[nodiscard]] Span<T> span() { return Span<T>(comps.data(), n); }
+    [[nodiscard]] Span<const T> span() const { return Span<const T>(comps.data(), n); }
+
+    // Operators (Addition, subtraction, negation and coefficients are lazy, see VectorExpression.hpp)
+    friend std::ostream& operator<<(std::ostream& os, const BasicVector& vec) {    // Printing vec.toString()
+        os << "( ";
+        for(std::size_t i = 0; i < vec.n; i++) {
+            os << vec.comps[i];
+            if(i != vec.n-1)
+                os << ", ";
+        }
+        os << " )\n";
+        return os;
+    }
+    friend BasicVector operator^(const BasicVector& lhs, const BasicVector& rhs) {  // Cross Product
+        return lhs.cross(rhs);
+    }
 
     // Class Operators
-    Vector operator-() const;    // Vector negation ( -1 * (*this) )
-    double& operator[](std::size_t n);
-    const double& operator[](std::size_t n) const;
+    T& operator[](std::size_t i) { checkIndexByPolicy(i, n); return comps[i]; }
+    const T& operator[](std::size_t i) const { checkIndexByPolicy(i, n); return comps[i]; }
+    operator BasicVectorView<T>();                  // Non-owning views of all components
+    operator BasicVectorView<const T>() const;
 
     // Destructor
-    ~Vector() = default;
+    ~BasicVector() = default;
 };
 
+template<typename T>
+template<typename E, typename>
+BasicVector<T>::BasicVector(const VectorExpression<E>& expr) : VectorExpression<BasicVector<T>>() {
+    n = expr.derived().getDimension();
+    comps.resize(n);
+    assign(expr.derived(), 0, n);
+}
+
+template<typename T>
+template<typename E, typename>
+BasicVector<T>::BasicVector(ExecutionPolicy policy, const VectorExpression<E>& expr) : VectorExpression<BasicVector<T>>() {
+    n = expr.derived().getDimension();
+    comps.resize(n);
+    forEachChunk(policy, n, EXECUTION_CHUNK, [&](std::size_t begin, std::size_t end) {
+        assign(expr.derived(), begin, end);
+    });
+}
+
+template<typename T>
+template<typename U, typename>
+BasicVector<T>::BasicVector(const BasicVector<U>& vec) : VectorExpression<BasicVector<T>>() {
+    n = vec.getDimension();
+    comps.resize(n);
+    for(std::size_t i = 0; i < n; i++)
+        comps[i] = static_cast<T>(vec.element(i));
+}
+
+template<typename T>
+template<typename E>
+BasicVector<T>& BasicVector<T>::operator=(const VectorExpression<E>& expr) {
+    static_assert(sameScalar<BasicVector, E>, "Operands of different element types");
+    if(expr.derived().getDimension() != n) {
+        BasicVector result(expr);
+        return *this = std::move(result);
+    }
+    assign(expr.derived(), 0, n);
+    return *this;
+}
+
+template<typename T>
+template<typename E>
+BasicVector<T>& BasicVector<T>::assign(ExecutionPolicy policy, const VectorExpression<E>& expr) {
+    static_assert(sameScalar<BasicVector, E>, "Operands of different element types");
+    if(expr.derived().getDimension() != n) {
+        BasicVector result(policy, expr);
+        return *this = std::move(result);
+    }
+    forEachChunk(policy, n, EXECUTION_CHUNK, [&](std::size_t begin, std::size_t end) {
+        assign(expr.derived(), begin, end);
+    });
+    return *this;
+}
+
+// Single-pass evaluation of components [begin, end). Element-wise expressions never read an element
+// after writing it, so the destination may appear in the expression (x = x + y), and disjoint ranges
+// may be evaluated concurrently. Plain sums and scalings of double Vectors use the SIMD kernels.
+template<typename T>
+template<typename E>
+void BasicVector<T>::assign(const E& expr, std::size_t begin, std::size_t end) {
+    const VectorKernels& kernels = activeVectorKernels();
+    std::size_t count = end - begin;
+    if constexpr(std::is_same_v<E, VectorSum<Vector, Vector>>) {
+        kernels.add(expr.left().comps.data() + begin, expr.right().comps.data() + begin, comps.data() + begin, count);
+    } else if constexpr(std::is_same_v<E, VectorScaled<Vector>>) {
+        kernels.scale(expr.operand().comps.data() + begin, expr.coefficient(), comps.data() + begin, count);
+    } else if constexpr(std::is_same_v<E, VectorSum<VectorScaled<Vector>, Vector>>) {
+        // y + a * x: copy y, then one axpy pass (unless x is the destination itself)
+        if(&expr.left().operand() == this) {
+            for(std::size_t i = begin; i < end; i++)
+                comps[i] = expr.element(i);
+        } else {
+            if(&expr.right() != this)
+                std::copy(expr.right().comps.data() + begin, expr.right().comps.data() + end, comps.data() + begin);
+            kernels.axpy(expr.left().coefficient(), expr.left().operand().comps.data() + begin, comps.data() + begin, count);
+        }
+    } else {
+        for(std::size_t i = begin; i < end; i++)
+            comps[i] = expr.element(i);
+    }
+}
+
+template<typename T>
+template<typename E>
+BasicVector<T>& BasicVector<T>::operator+=(const VectorExpression<E>& expr) {
+    static_assert(sameScalar<BasicVector, E>, "Operands of different element types");
+    if(expr.derived().getDimension() != n)
+        throw std::invalid_argument("Vector addition is defined only for two same dimensional vectors!");
+    accumulate(expr.derived(), 1.0);
+    return *this;
+}
+
+template<typename T>
+template<typename E>
+BasicVector<T>& BasicVector<T>::operator-=(const VectorExpression<E>& expr) {
+    static_assert(sameScalar<BasicVector, E>, "Operands of different element types");
+    if(expr.derived().getDimension() != n)
+        throw std::invalid_argument("Vector subtraction is defined only for two same dimensional vectors!");
+    accumulate(expr.derived(), -1.0);
+    return *this;
+}
+
+// this += sign * expr; double Vectors and scaled Vectors become a single axpy pass.
+template<typename T>
+template<typename E>
+void BasicVector<T>::accumulate(const E& expr, double sign) {
+    const VectorKernels& kernels = activeVectorKernels();
+    if constexpr(std::is_same_v<E, Vector>) {
+        kernels.axpy(sign, expr.comps.data(), comps.data(), n);
+    } else if constexpr(std::is_same_v<E, VectorScaled<Vector>>) {
+        kernels.axpy(sign * expr.coefficient(), expr.operand().comps.data(), comps.data(), n);
+    } else {
+        for(std::size_t i = 0; i < n; i++)
+            comps[i] = roundToScalar<T>(comps[i] + sign * expr.element(i));
+    }
+}
+
+extern template class BasicVector<double>;
+extern template class BasicVector<float>;
+extern template class BasicVector<int>;
+
 #endif // LINEAROBJECTS_HPP
@@ -0,0 +1,83 @@
+#ifndef VECTORBATCH_HPP
+#define VECTORBATCH_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "AlignedAllocator.hpp"
+#include "MatrixView.hpp"
+#include "Vector.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Many vectors of the same dimension (a point cloud, a set of normals, ...) stored as a structure of
+// arrays: component c of every vector forms one contiguous, 64-byte aligned lane. Instead of one heap
+// object and one call per vector, the batch operations below stream whole lanes through the SIMD kernels
+// (VectorKernels.hpp), a cache-sized block of vectors at a time, and large batches are split across the
+// thread pool. Results are identical for any thread count.
+// Every operation works per vector: dot() returns the count dot products a[i] . b[i], and so on.
+// The Vector-returning forms allocate their result; the forms taking a VectorView write into it instead
+// (it must hold getCount() contiguous elements).
+class VectorBatch {
+private:
+    AlignedBuffer data{};   // Component c of vector i lives at data[c * stride + i]
+    std::size_t dimension{};
+    std::size_t count{};
+    std::size_t stride{};   // count rounded up to whole cache lines, so that every lane starts aligned
+
+    double* lane(std::size_t component) { return data.data() + component * stride; }
+    [[nodiscard]] const double* lane(std::size_t component) const { return data.data() + component * stride; }
+
+public:
+    // Constructors
+    VectorBatch(std::size_t vectorDimension, std::size_t vectorCount);   // vectorCount zero vectors
+    explicit VectorBatch(const std::vector<Vector>& vectors);
+
+    // (Move & Copy) (Constructor & Assignment)
+    VectorBatch(const VectorBatch& batch) = default;
+    VectorBatch(VectorBatch&& batch) = default;
+    VectorBatch& operator=(const VectorBatch& batch) = default;
+    VectorBatch& operator=(VectorBatch&& batch) = default;
+
+    // Compound Assignment (in place, never allocates)
+    VectorBatch& operator+=(const VectorBatch& rhs);
+    VectorBatch& operator-=(const VectorBatch& rhs);
+    VectorBatch& operator*=(double coeff);
+
+    // Methods
+    [[nodiscard]] Vector dot(const VectorBatch& rhs) const;
+    void dot(const VectorBatch& rhs, VectorView result) const;
+    [[nodiscard]] Vector magnitude() const;
+    void magnitude(VectorView result) const;
+    [[nodiscard]] Vector angle(const VectorBatch& rhs) const;    // In Radians
+    void angle(const VectorBatch& rhs, VectorView result) const;
+    [[nodiscard]] VectorBatch cross(const VectorBatch& rhs) const;   // Also spelled lhs ^ rhs
+    void cross(const VectorBatch& rhs, VectorBatch& result) const;
+    // matrix * v for every v; matrix must have getDimension() columns, the result has its row count
+    [[nodiscard]] VectorBatch transform(ConstMatrixView matrix) const;   // Also spelled matrix * batch
+    void transform(ConstMatrixView matrix, VectorBatch& result) const;
+    [[nodiscard]] std::vector<Vector> toVectors() const;
+
+    // Getters
+    [[nodiscard]] std::size_t getDimension() const;
+    [[nodiscard]] std::size_t getCount() const;
+    [[nodiscard]] Vector getVector(std::size_t idx) const;
+    [[nodiscard]] VectorView component(std::size_t idx);            // Lane idx: that component of every vector
+    [[nodiscard]] ConstVectorView component(std::size_t idx) const;
+
+    // Setters
+    VectorBatch& setVector(std::size_t idx, const Vector& vec);
+
+    // Friend Operators
+    friend VectorBatch operator+(const VectorBatch& lhs, const VectorBatch& rhs);
+    friend VectorBatch operator-(const VectorBatch& lhs, const VectorBatch& rhs);
+    friend VectorBatch operator*(double coeff, const VectorBatch& batch);
+    friend VectorBatch operator*(const VectorBatch& batch, double coeff);
+    friend VectorBatch operator^(const VectorBatch& lhs, const VectorBatch& rhs);   // Cross Product
+    friend VectorBatch operator*(ConstMatrixView matrix, const VectorBatch& batch);
+
+    // Destructor
+    ~VectorBatch() = default;
+};
+
+#endif //VECTORBATCH_HPP
@@ -0,0 +1,164 @@
+#ifndef VECTOREXPRESSION_HPP
+#define VECTOREXPRESSION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Scalar.hpp"
+
+// Lazy vector arithmetic. `a * x + b * y + z` builds a small tree of expression objects instead of
+// one temporary Vector per operator; the tree is evaluated element by element, in a single pass,
+// when it is assigned to (or used to construct) a Vector.
+// Expressions refer to the Vectors they were built from, so they should not outlive the full
+// expression: `auto e = x + y;` followed by changing x or y changes what e evaluates to.
+// Every expression has a Scalar type (its elements' type); the operands of a node must share it.
+template<typename E>
+class VectorExpression {
+protected:
+    VectorExpression() = default;
+    VectorExpression(const VectorExpression&) = default;
+    VectorExpression& operator=(const VectorExpression&) = default;
+    ~VectorExpression() = default;
+
+public:
+    [[nodiscard]] const E& derived() const { return static_cast<const E&>(*this); }
+
+    // Evaluates a single element of the expression
+    auto operator[](std::size_t i) const {
+        if(i >= derived().getDimension())
+            throw std::invalid_argument("Index out of bound");
+        return derived().element(i);
+    }
+};
+
+// Vectors are held by reference, intermediate nodes (a couple of words each) by value.
+template<typename E>
+struct VectorOperand {
+    using type = const E;
+};
+
+template<typename T>
+struct VectorOperand<BasicVector<T>> {
+    using type = const BasicVector<T>&;
+};
+
+template<typename E>
+inline constexpr bool isVector = false;
+
+template<typename T>
+inline constexpr bool isVector<BasicVector<T>> = true;
+
+// Mixing element types would convert silently; convert explicitly instead (FloatVector(x), Vector(y)).
+template<typename L, typename R>
+inline constexpr bool sameScalar = std::is_same_v<typename L::Scalar, typename R::Scalar>;
+
+template<typename L, typename R>
+class VectorSum : public VectorExpression<VectorSum<L, R>> {
+    static_assert(sameScalar<L, R>, "Operands of different element types");
+
+private:
+    typename VectorOperand<L>::type lhs;
+    typename VectorOperand<R>::type rhs;
+
+public:
+    using Scalar = typename L::Scalar;
+
+    VectorSum(const L& left, const R& right) : lhs(left), rhs(right) {
+        if(lhs.getDimension() != rhs.getDimension())
+            throw std::invalid_argument("Vector addition is defined only for two same dimensional vectors!");
+    }
+
+    [[nodiscard]] std::size_t getDimension() const { return lhs.getDimension(); }
+    [[nodiscard]] Scalar element(std::size_t i) const { return lhs.element(i) + rhs.element(i); }
+    [[nodiscard]] const L& left() const { return lhs; }
+    [[nodiscard]] const R& right() const { return rhs; }
+};
+
+template<typename L, typename R>
+class VectorDifference : public VectorExpression<VectorDifference<L, R>> {
+    static_assert(sameScalar<L, R>, "Operands of different element types");
+
+private:
+    typename VectorOperand<L>::type lhs;
+    typename VectorOperand<R>::type rhs;
+
+public:
+    using Scalar = typename L::Scalar;
+
+    VectorDifference(const L& left, const R& right) : lhs(left), rhs(right) {
+        if(lhs.getDimension() != rhs.getDimension())
+            throw std::invalid_argument("Vector subtraction is defined only for two same dimensional vectors!");
+    }
+
+    [[nodiscard]] std::size_t getDimension() const { return lhs.getDimension(); }
+    [[nodiscard]] Scalar element(std::size_t i) const { return lhs.element(i) - rhs.element(i); }
+};
+
+template<typename E>
+class VectorScaled : public VectorExpression<VectorScaled<E>> {
+private:
+    double coeff{};
+    typename VectorOperand<E>::type vec;
+
+public:
+    using Scalar = typename E::Scalar;
+
+    VectorScaled(double coefficient, const E& operand) : coeff(coefficient), vec(operand) {}
+
+    [[nodiscard]] std::size_t getDimension() const { return vec.getDimension(); }
+    [[nodiscard]] Scalar element(std::size_t i) const { return roundToScalar<Scalar>(coeff * vec.element(i)); }
+    [[nodiscard]] double coefficient() const { return coeff; }
+    [[nodiscard]] const E& operand() const { return vec; }
+};
+
+// Operators
+
+template<typename L, typename R>
+VectorSum<L, R> operator+(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs) {
+    return VectorSum<L, R>(lhs.derived(), rhs.derived());
+}
+
+template<typename L, typename R>
+VectorDifference<L, R> operator-(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs) {
+    return VectorDifference<L, R>(lhs.derived(), rhs.derived());
+}
+
+template<typename E>
+VectorScaled<E> operator*(double coeff, const VectorExpression<E>& vec) {
+    return VectorScaled<E>(coeff, vec.derived());
+}
+
+template<typename E>
+VectorScaled<E> operator*(const VectorExpression<E>& vec, double coeff) {
+    return VectorScaled<E>(coeff, vec.derived());
+}
+
+// Vector negation ( -1 * vec )
+template<typename E>
+VectorScaled<E> operator-(const VectorExpression<E>& vec) {
+    return VectorScaled<E>(-1.0, vec.derived());
+}
+
+// Dot Product, accumulated in Accumulator<Scalar> (see Scalar.hpp). Two Vectors use the SIMD kernel;
+// expressions are fused so they are never materialized.
+template<typename L, typename R>
+auto operator*(const VectorExpression<L>& lhs, const VectorExpression<R>& rhs) {
+    static_assert(sameScalar<L, R>, "Operands of different element types");
+    using Sum = Accumulator<typename L::Scalar>;
+    const L& left = lhs.derived();
+    const R& right = rhs.derived();
+    if constexpr(isVector<L> && std::is_same_v<L, R>) {
+        return left.dot(right);
+    } else {
+        if(left.getDimension() != right.getDimension())
+            throw std::invalid_argument("Dot product is defined only for two same dimensional vectors!");
+
+        Sum sum = 0;
+        for(std::size_t i = 0; i < left.getDimension(); i++)
+            sum += static_cast<Sum>(left.element(i)) * static_cast<Sum>(right.element(i));
+        return sum;
+    }
+}
+
+#endif //VECTOREXPRESSION_HPP
@@ -0,0 +1,26 @@
+#ifndef VECTORKERNELS_HPP
+#define VECTORKERNELS_HPP
+
+#include <cstddef>
+
+// Dense double-precision kernels behind Vector's arithmetic (and VectorBatch's element-wise ones), plus the
+// mixed-precision dot product of FloatVector (float loads widened to double before the multiply-add).
+// One table exists per instruction set; the best one the CPU (and OS) supports is picked on first use.
+// Setting LINEAROBJECTS_SIMD to scalar, sse2, avx2 or avx512 caps the choice, e.g. to compare against the
+// scalar reference. Output pointers may alias inputs.
+struct VectorKernels {
+    const char* name;
+    double (*dot)(const double* lhs, const double* rhs, std::size_t n);
+    double (*dotFloat)(const float* lhs, const float* rhs, std::size_t n);               // Accumulated in double
+    void (*add)(const double* lhs, const double* rhs, double* out, std::size_t n);       // out = lhs + rhs
+    void (*scale)(const double* vec, double coeff, double* out, std::size_t n);          // out = coeff * vec
+    void (*axpy)(double coeff, const double* vec, double* out, std::size_t n);           // out += coeff * vec
+    void (*multiply)(const double* lhs, const double* rhs, double* out, std::size_t n);  // out = lhs * rhs
+    void (*multiplyAdd)(double coeff, const double* lhs, const double* rhs, double* out, std::size_t n);   // out += coeff * lhs * rhs
+    void (*squareRoot)(const double* vec, double* out, std::size_t n);                   // out = sqrt(vec)
+};
+
+[[nodiscard]] const VectorKernels& activeVectorKernels();
+[[nodiscard]] const VectorKernels& scalarVectorKernels();
+
+#endif //VECTORKERNELS_HPP
@@ -0,0 +1,129 @@
+#ifndef VECTORVIEW_HPP
+#define VECTORVIEW_HPP
+
+#include <cstddef>
+#include <initializer_list>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "BoundsCheck.hpp"
+#include "VectorExpression.hpp"
+
+// Note: All Objects Are Zero-Origin Based !
+
+// Non-owning, strided window onto elements that live elsewhere: a whole Vector, or a row, column,
+// sub-row or sub-column of a Matrix. Copying a view copies the handle; assigning to a view writes
+// through to the elements it refers to. A view must not outlive its owner, and anything that
+// reallocates the owner (a resizing assignment, Matrix::transpose(), ...) leaves it dangling.
+// Views are VectorExpressions, so they mix freely with Vectors in the lazy arithmetic. The
+// destination may appear in the expression assigned to it (r = r + s), but a source that only
+// partially overlaps the destination is not supported.
+template<typename T>
+class BasicVectorView : public VectorExpression<BasicVectorView<T>> {
+private:
+    T* first{};
+    std::size_t n{};
+    std::size_t step{};     // Distance (in elements) between two consecutive elements
+
+    void checkDimension(std::size_t dimension) const {
+        if(dimension != n)
+            throw std::invalid_argument("Vector should contain " + std::to_string(n) + " Elements");
+    }
+
+public:
+    using Scalar = std::remove_const_t<T>;
+
+    // Constructors
+    constexpr BasicVectorView(T* start, std::size_t length, std::size_t elementStride = 1)
+        : VectorExpression<BasicVectorView<T>>(), first(start), n(length), step(elementStride) {}
+    constexpr BasicVectorView(const BasicVectorView& view) = default;
+
+    // Assignment copies elements (not the handle)
+    BasicVectorView& operator=(const BasicVectorView& view) {
+        return *this = static_cast<const VectorExpression<BasicVectorView>&>(view);
+    }
+
+    template<typename E>
+    BasicVectorView& operator=(const VectorExpression<E>& expr) {
+        static_assert(sameScalar<BasicVectorView, E>, "Operands of different element types");
+        checkDimension(expr.derived().getDimension());
+        for(std::size_t i = 0; i < n; i++)
+            first[i * step] = expr.derived().element(i);
+        return *this;
+    }
+
+    BasicVectorView& operator=(std::initializer_list<Scalar> components) {
+        checkDimension(components.size());
+        std::size_t i = 0;
+        for(Scalar component: components)
+            first[i++ * step] = component;
+        return *this;
+    }
+
+    // Compound Assignment
+    template<typename E>
+    BasicVectorView& operator+=(const VectorExpression<E>& expr) {
+        static_assert(sameScalar<BasicVectorView, E>, "Operands of different element types");
+        if(expr.derived().getDimension() != n)
+            throw std::invalid_argument("Vector addition is defined only for two same dimensional vectors!");
+        for(std::size_t i = 0; i < n; i++)
+            first[i * step] += expr.derived().element(i);
+        return *this;
+    }
+
+    template<typename E>
+    BasicVectorView& operator-=(const VectorExpression<E>& expr) {
+        static_assert(sameScalar<BasicVectorView, E>, "Operands of different element types");
+        if(expr.derived().getDimension() != n)
+            throw std::invalid_argument("Vector subtraction is defined only for two same dimensional vectors!");
+        for(std::size_t i = 0; i < n; i++)
+            first[i * step] -= expr.derived().element(i);
+        return *this;
+    }
+
+    BasicVectorView& operator*=(double coeff) {
+        for(std::size_t i = 0; i < n; i++)
+            first[i * step] = roundToScalar<Scalar>(coeff * first[i * step]);
+        return *this;
+    }
+
+    // Methods
+    [[nodiscard]] constexpr std::size_t getDimension() const { return n; }
+    [[nodiscard]] constexpr std::size_t getStride() const { return step; }
+    [[nodiscard]] constexpr T* data() const { return first; }
+    [[nodiscard]] constexpr Scalar element(std::size_t i) const { return first[i * step]; }   // Unchecked
+    [[nodiscard]] constexpr T& at(std::size_t idx) const {
+        checkIndex(idx, n);
+        return first[idx * step];
+    }
+
+    // Friend Operators
+    friend std::ostream& operator<<(std::ostream& os, const BasicVectorView& view) {
+        os << "( ";
+        for(std::size_t i = 0; i < view.n; i++) {
+            os << view.element(i);
+            if(i != view.n - 1)
+                os << ", ";
+        }
+        os << " )\n";
+        return os;
+    }
+
+    // Class Operators
+    constexpr T& operator[](std::size_t idx) const {     // Checked by policy (see BoundsCheck.hpp)
+        checkIndexByPolicy(idx, n);
+        return first[idx * step];
+    }
+
+    constexpr operator BasicVectorView<const T>() const { return BasicVectorView<const T>(first, n, step); }
+
+    // Destructor
+    ~BasicVectorView() = default;
+};
+
+using VectorView = BasicVectorView<double>;
+using ConstVectorView = BasicVectorView<const double>;
+
+#endif //VECTORVIEW_HPP
@@ -0,0 +1,189 @@
+#include "CholeskyDecomposition.hpp"
+
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Gemm.hpp"
+#include "ThreadPool.hpp"
+#include "VectorKernels.hpp"
+
+namespace {
+
+// Factorizations of fewer rows than this run on the calling thread only.
+constexpr std::size_t PARALLEL_THRESHOLD = 256;
+
+template<typename Body>
+void forEachTask(std::size_t count, bool parallel, const Body& body) {
+    if(!parallel || count == 1) {
+        for(std::size_t idx = 0; idx < count; idx++)
+            body(idx);
+        return;
+    }
+    ThreadPool::instance().parallelFor(count, body);
+}
+
+}
+
+// Constructors
+
+CholeskyDecomposition::CholeskyDecomposition(const SymmetricMatrix& matrix) : factor(matrix) {
+    factorize();
+}
+
+// Methods
+
+// For each diagonal tile k:
+//   1. L_kk = cholesky(A_kk), element by element (dot products along its rows);
+//   2. L_Ik = A_Ik L_kk^-T for every tile I below it;
+//   3. A_IJ -= L_Ik L_Jk^T for every trailing tile k < J <= I (one multiply-kernel call each).
+// Steps 2 and 3 write distinct tiles, so each is one parallel batch.
+void CholeskyDecomposition::factorize() {
+    const VectorKernels& kernels = activeVectorKernels();
+    std::size_t T = factor.tileSize;
+    std::size_t tileCount = factor.tileCount;
+    bool parallel = factor.n >= PARALLEL_THRESHOLD;
+    std::vector<std::pair<std::size_t, std::size_t>> trailing;
+    trailing.reserve((tileCount * (tileCount + 1)) / 2);
+
+    for(std::size_t k = 0; k < tileCount; k++) {
+        double* diagonal = factor.tile(k, k);
+        std::size_t extent = factor.tileExtent(k);
+        for(std::size_t j = 0; j < extent; j++) {
+            double* row = diagonal + j * T;
+            double pivot = row[j] - kernels.dot(row, row, j);
+            if(!(pivot > 0.0))
+                throw std::invalid_argument("Matrix is not positive definite!");
+            row[j] = std::sqrt(pivot);
+            for(std::size_t i = j + 1; i < extent; i++) {
+                double* lower = diagonal + i * T;
+                lower[j] = (lower[j] - kernels.dot(lower, row, j)) / row[j];
+                row[i] = 0.0;
+            }
+        }
+
+        forEachTask(tileCount - k - 1, parallel, [&](std::size_t idx) {
+            double* block = factor.tile(k + 1 + idx, k);
+            for(std::size_t r = 0; r < factor.tileExtent(k + 1 + idx); r++) {
+                double* row = block + r * T;
+                for(std::size_t j = 0; j < extent; j++)
+                    row[j] = (row[j] - kernels.dot(row, diagonal + j * T, j)) / diagonal[j * T + j];
+            }
+        });
+
+        trailing.clear();
+        for(std::size_t I = k + 1; I < tileCount; I++)
+            for(std::size_t J = k + 1; J <= I; J++)
+                trailing.emplace_back(I, J);
+        forEachTask(trailing.size(), parallel, [&](std::size_t idx) {
+            auto [I, J] = trailing[idx];
+            blockedGemm(GemmShape{factor.tileExtent(I), factor.tileExtent(J), extent}, -1.0,
+                        GemmOperand{factor.tile(I, k), T, 1}, GemmOperand{factor.tile(J, k), 1, T},
+                        1.0, GemmResult{factor.tile(I, J), T});
+        });
+    }
+}
+
+double CholeskyDecomposition::logDeterminant() const {
+    double result = 0.0;
+    for(std::size_t i = 0; i < factor.n; i++)
+        result += std::log(factor.data[factor.offset(i, i)]);
+    return 2.0 * result;
+}
+
+// L y = rhs by rows (dot products), then L^T x = y by columns (axpys), both a tile at a time.
+Vector CholeskyDecomposition::solve(ConstVectorView rhs) const {
+    std::size_t n = factor.n;
+    if(rhs.getDimension() != n)
+        throw std::invalid_argument("Vector should contain " + std::to_string(n) + " Elements");
+    const VectorKernels& kernels = activeVectorKernels();
+    std::size_t T = factor.tileSize;
+    Vector result(rhs);
+    VectorView view = result;
+    double* x = view.data();
+
+    for(std::size_t I = 0; I < factor.tileCount; I++) {
+        double* xI = x + I * T;
+        for(std::size_t r = 0; r < factor.tileExtent(I); r++) {
+            for(std::size_t J = 0; J < I; J++)
+                xI[r] -= kernels.dot(factor.tile(I, J) + r * T, x + J * T, T);
+            const double* row = factor.tile(I, I) + r * T;
+            xI[r] = (xI[r] - kernels.dot(row, xI, r)) / row[r];
+        }
+    }
+
+    for(std::size_t I = factor.tileCount; I-- > 0;) {
+        double* xI = x + I * T;
+        std::size_t extent = factor.tileExtent(I);
+        for(std::size_t J = I + 1; J < factor.tileCount; J++)
+            for(std::size_t p = 0; p < factor.tileExtent(J); p++)
+                kernels.axpy(-x[J * T + p], factor.tile(J, I) + p * T, xI, extent);
+        for(std::size_t p = extent; p-- > 0;) {
+            const double* row = factor.tile(I, I) + p * T;
+            xI[p] /= row[p];
+            kernels.axpy(-xI[p], row, xI, p);
+        }
+    }
+    return result;
+}
+
+// The same two sweeps over rows of the right-hand sides; contributions of other tiles are one
+// multiply-kernel call each.
+Matrix CholeskyDecomposition::solve(ConstMatrixView rhs) const {
+    std::size_t n = factor.n;
+    if(rhs.getDimension().rowCount != n)
+        throw std::invalid_argument("Right-hand side should contain " + std::to_string(n) + " Rows");
+    const VectorKernels& kernels = activeVectorKernels();
+    std::size_t T = factor.tileSize;
+    std::size_t m = rhs.getDimension().columnCount;
+    Matrix result(rhs);
+    MatrixView view = result;
+    double* x = view.data();
+    std::size_t ldx = view.getStride();
+
+    for(std::size_t I = 0; I < factor.tileCount; I++) {
+        double* xI = x + I * T * ldx;
+        std::size_t extent = factor.tileExtent(I);
+        for(std::size_t J = 0; J < I; J++)
+            blockedGemm(GemmShape{extent, m, T}, -1.0, GemmOperand{factor.tile(I, J), T, 1},
+                        GemmOperand{x + J * T * ldx, ldx, 1}, 1.0, GemmResult{xI, ldx});
+        for(std::size_t r = 0; r < extent; r++) {
+            const double* row = factor.tile(I, I) + r * T;
+            for(std::size_t p = 0; p < r; p++)
+                kernels.axpy(-row[p], xI + p * ldx, xI + r * ldx, m);
+            kernels.scale(xI + r * ldx, 1.0 / row[r], xI + r * ldx, m);
+        }
+    }
+
+    for(std::size_t I = factor.tileCount; I-- > 0;) {
+        double* xI = x + I * T * ldx;
+        std::size_t extent = factor.tileExtent(I);
+        for(std::size_t J = I + 1; J < factor.tileCount; J++)
+            blockedGemm(GemmShape{extent, m, factor.tileExtent(J)}, -1.0, GemmOperand{factor.tile(J, I), 1, T},
+                        GemmOperand{x + J * T * ldx, ldx, 1}, 1.0, GemmResult{xI, ldx});
+        for(std::size_t p = extent; p-- > 0;) {
+            const double* row = factor.tile(I, I) + p * T;
+            kernels.scale(xI + p * ldx, 1.0 / row[p], xI + p * ldx, m);
+            for(std::size_t r = 0; r < p; r++)
+                kernels.axpy(-row[r], xI + p * ldx, xI + r * ldx, m);
+        }
+    }
+    return result;
+}
+
+SquareMatrix CholeskyDecomposition::lower() const {
+    std::size_t n = factor.n;
+    SquareMatrix result(n);
+    for(std::size_t i = 0; i < n; i++)
+        for(std::size_t j = 0; j <= i; j++)
+            result[i][j] = factor.data[factor.offset(i, j)];
+    return result;
+}
+
+// Getters
+
+std::size_t CholeskyDecomposition::getDimension() const {
+    return factor.n;
+}
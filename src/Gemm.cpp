@@ -0,0 +1,272 @@
+#include "Gemm.hpp"
+
+#include <algorithm>
+
+#include "AlignedAllocator.hpp"
+#include "ThreadPool.hpp"
+
+namespace {
+
+// Register tile computed by one micro-kernel call (MR x NR accumulators stay in registers).
+constexpr std::size_t MR = 4;
+constexpr std::size_t NR = 8;
+
+// Cache blocking: an MC x KC panel of A targets L2, a KC x NR sliver of B targets L1
+// and the KC x NC block of B targets the last-level cache.
+constexpr std::size_t MC = 128;
+constexpr std::size_t KC = 256;
+constexpr std::size_t NC = 4096;
+
+// Products below this many multiply-adds are not worth waking the thread pool for.
+constexpr std::size_t PARALLEL_THRESHOLD = 128 * 128 * 128;
+
+// Each parallel step aims for this many tasks per thread so work stealing can even out the load.
+constexpr std::size_t TASKS_PER_THREAD = 4;
+
+// Packs the (mc x kc) block of A starting at (rowStart, depthStart) into MR-row panels,
+// element (i, p) of a panel stored at p * MR + i. Short panels are zero padded. Alpha is folded in here
+// (and float elements are widened to double).
+template<typename T>
+void packA(const BasicGemmOperand<T>& a, std::size_t rowStart, std::size_t depthStart,
+           std::size_t mc, std::size_t kc, double alpha, double* packed) {
+    for(std::size_t ir = 0; ir < mc; ir += MR) {
+        std::size_t mr = std::min(MR, mc - ir);
+        for(std::size_t p = 0; p < kc; p++) {
+            const T* column = a.data + (rowStart + ir) * a.rowStride + (depthStart + p) * a.columnStride;
+            for(std::size_t i = 0; i < mr; i++)
+                packed[i] = alpha * column[i * a.rowStride];
+            for(std::size_t i = mr; i < MR; i++)
+                packed[i] = 0.0;
+            packed += MR;
+        }
+    }
+}
+
+// Packs the (kc x nc) block of B starting at (depthStart, columnStart) into NR-column slivers,
+// element (p, j) of a sliver stored at p * NR + j. Short slivers are zero padded.
+template<typename T>
+void packB(const BasicGemmOperand<T>& b, std::size_t depthStart, std::size_t columnStart,
+           std::size_t kc, std::size_t nc, double* packed) {
+    for(std::size_t jr = 0; jr < nc; jr += NR) {
+        std::size_t nr = std::min(NR, nc - jr);
+        for(std::size_t p = 0; p < kc; p++) {
+            const T* row = b.data + (depthStart + p) * b.rowStride + (columnStart + jr) * b.columnStride;
+            for(std::size_t j = 0; j < nr; j++)
+                packed[j] = static_cast<double>(row[j * b.columnStride]);
+            for(std::size_t j = nr; j < NR; j++)
+                packed[j] = 0.0;
+            packed += NR;
+        }
+    }
+}
+
+// acc = Apanel * Bsliver, the whole MR x NR tile in registers.
+inline void multiplyTile(std::size_t kc, const double* a, const double* b, double (&acc)[MR][NR]) {
+    for(std::size_t p = 0; p < kc; p++, a += MR, b += NR)
+        for(std::size_t i = 0; i < MR; i++)
+            for(std::size_t j = 0; j < NR; j++)
+                acc[i][j] += a[i] * b[j];
+}
+
+// C[0:mr, 0:nr] += Apanel * Bsliver
+void microKernel(std::size_t kc, const double* a, const double* b,
+                 double* c, std::size_t ldc, std::size_t mr, std::size_t nr) {
+    double acc[MR][NR]{};
+    multiplyTile(kc, a, b, acc);
+
+    for(std::size_t i = 0; i < mr; i++)
+        for(std::size_t j = 0; j < nr; j++)
+            c[i * ldc + j] += acc[i][j];
+}
+
+// C[0:mr, 0:nr] = Apanel * Bsliver + beta * C for a float C, rounded once from the registers
+void microKernelRound(std::size_t kc, const double* a, const double* b,
+                      float* c, std::size_t ldc, std::size_t mr, std::size_t nr, double beta) {
+    double acc[MR][NR]{};
+    multiplyTile(kc, a, b, acc);
+
+    for(std::size_t i = 0; i < mr; i++)
+        for(std::size_t j = 0; j < nr; j++)
+            c[i * ldc + j] = static_cast<float>(beta == 0.0 ? acc[i][j] : beta * c[i * ldc + j] + acc[i][j]);
+}
+
+std::size_t ceilDiv(std::size_t value, std::size_t divisor) {
+    return (value + divisor - 1) / divisor;
+}
+
+// Runs body(0) ... body(count - 1), on the thread pool when parallel is set.
+// Tasks always cover the same output elements in the same order, so results do not depend on the thread count.
+template<typename Body>
+void runTasks(bool parallel, std::size_t count, const Body& body) {
+    if(parallel) {
+        ThreadPool::instance().parallelFor(count, body);
+    } else {
+        for(std::size_t i = 0; i < count; i++)
+            body(i);
+    }
+}
+
+template<typename U>
+void scaleResult(const GemmShape& shape, double beta, const BasicGemmResult<U>& c) {
+    if(beta == 1.0)
+        return;
+    for(std::size_t i = 0; i < shape.rowCount; i++) {
+        U* row = c.data + i * c.rowStride;
+        if(beta == 0.0)
+            std::fill(row, row + shape.columnCount, U{});
+        else
+            for(std::size_t j = 0; j < shape.columnCount; j++)
+                row[j] = static_cast<U>(beta * row[j]);
+    }
+}
+
+template<typename T>
+void gemmDriver(GemmShape shape, double alpha, const BasicGemmOperand<T>& a, const BasicGemmOperand<T>& b,
+                double beta, GemmResult c) {
+    if(shape.rowCount == 0 || shape.columnCount == 0)
+        return;
+
+    scaleResult(shape, beta, c);
+    if(shape.depth == 0 || alpha == 0.0)
+        return;
+
+    std::size_t threadCount = ThreadPool::instance().getThreadCount();
+    bool parallel = threadCount > 1 &&
+                    shape.rowCount * shape.columnCount * shape.depth >= PARALLEL_THRESHOLD;
+
+    // The packed B block is shared by every task of a step; A panels are packed per task.
+    // Kept across calls, so never taken from a scoped arena (MemoryResource.hpp)
+    thread_local AlignedBuffer packedB{AlignedAllocator<double>(alignedHeapResource())};
+    packedB.resize(KC * ceilDiv(std::min(NC, shape.columnCount), NR) * NR);
+    double* sharedB = packedB.data();
+
+    std::size_t rowBlocks = ceilDiv(shape.rowCount, MC);
+
+    for(std::size_t jc = 0; jc < shape.columnCount; jc += NC) {
+        std::size_t nc = std::min(NC, shape.columnCount - jc);
+
+        // Split the columns into groups (whole NR slivers) so that rowBlocks x groups yields enough tasks.
+        std::size_t groupWidth = nc;
+        if(parallel) {
+            std::size_t groups = ceilDiv(TASKS_PER_THREAD * threadCount, rowBlocks);
+            groupWidth = std::max(NR, ceilDiv(ceilDiv(nc, groups), NR) * NR);
+        }
+        std::size_t groupCount = ceilDiv(nc, groupWidth);
+
+        for(std::size_t pc = 0; pc < shape.depth; pc += KC) {
+            std::size_t kc = std::min(KC, shape.depth - pc);
+
+            runTasks(parallel, groupCount, [&](std::size_t group) {
+                std::size_t jr = group * groupWidth;
+                packB(b, pc, jc + jr, kc, std::min(groupWidth, nc - jr), sharedB + jr * kc);
+            });
+
+            runTasks(parallel, rowBlocks * groupCount, [&](std::size_t task) {
+                // Kept across calls, so never taken from a scoped arena (MemoryResource.hpp)
+                thread_local AlignedBuffer packedA{AlignedAllocator<double>(alignedHeapResource())};
+                packedA.resize(MC * KC);
+
+                std::size_t ic = (task / groupCount) * MC;
+                std::size_t mc = std::min(MC, shape.rowCount - ic);
+                std::size_t groupStart = (task % groupCount) * groupWidth;
+                std::size_t groupEnd = std::min(nc, groupStart + groupWidth);
+
+                packA(a, ic, pc, mc, kc, alpha, packedA.data());
+                for(std::size_t jr = groupStart; jr < groupEnd; jr += NR) {
+                    std::size_t nr = std::min(NR, groupEnd - jr);
+                    for(std::size_t ir = 0; ir < mc; ir += MR) {
+                        std::size_t mr = std::min(MR, mc - ir);
+                        microKernel(kc, packedA.data() + ir * kc, sharedB + jr * kc,
+                                    c.data + (ic + ir) * c.rowStride + jc + jr, c.rowStride, mr, nr);
+                    }
+                }
+            });
+        }
+    }
+}
+
+// Float C: every task owns an MC-row by column-group tile of C for the whole depth, accumulated in a double
+// workspace with the same per-element order as above and rounded once when stored. Tasks no longer share a
+// depth step, so each packs its own B slivers (one extra pass over B per MC rows of C).
+template<typename T>
+void gemmDriver(GemmShape shape, double alpha, const BasicGemmOperand<T>& a, const BasicGemmOperand<T>& b,
+                double beta, BasicGemmResult<float> c) {
+    if(shape.rowCount == 0 || shape.columnCount == 0)
+        return;
+    if(shape.depth == 0 || alpha == 0.0) {
+        scaleResult(shape, beta, c);
+        return;
+    }
+
+    std::size_t threadCount = ThreadPool::instance().getThreadCount();
+    bool parallel = threadCount > 1 &&
+                    shape.rowCount * shape.columnCount * shape.depth >= PARALLEL_THRESHOLD;
+
+    std::size_t rowBlocks = ceilDiv(shape.rowCount, MC);
+    std::size_t groupCount = ceilDiv(shape.columnCount, NC);
+    if(parallel)
+        groupCount = std::max(groupCount, ceilDiv(TASKS_PER_THREAD * threadCount, rowBlocks));
+    std::size_t groupWidth = std::min(NC, std::max(NR, ceilDiv(ceilDiv(shape.columnCount, groupCount), NR) * NR));
+    groupCount = ceilDiv(shape.columnCount, groupWidth);
+
+    runTasks(parallel, rowBlocks * groupCount, [&](std::size_t task) {
+        // Kept across calls, so never taken from a scoped arena (MemoryResource.hpp)
+        thread_local AlignedBuffer packedA{AlignedAllocator<double>(alignedHeapResource())};
+        thread_local AlignedBuffer packedB{AlignedAllocator<double>(alignedHeapResource())};
+        thread_local AlignedBuffer workspace{AlignedAllocator<double>(alignedHeapResource())};
+        packedA.resize(MC * KC);
+        packedB.resize(KC * NR);
+
+        std::size_t ic = (task / groupCount) * MC;
+        std::size_t mc = std::min(MC, shape.rowCount - ic);
+        std::size_t jc = (task % groupCount) * groupWidth;
+        std::size_t nc = std::min(groupWidth, shape.columnCount - jc);
+        float* tile = c.data + ic * c.rowStride + jc;
+
+        if(shape.depth <= KC) {
+            packA(a, ic, 0, mc, shape.depth, alpha, packedA.data());
+            for(std::size_t jr = 0; jr < nc; jr += NR) {
+                std::size_t nr = std::min(NR, nc - jr);
+                packB(b, 0, jc + jr, shape.depth, nr, packedB.data());
+                for(std::size_t ir = 0; ir < mc; ir += MR)
+                    microKernelRound(shape.depth, packedA.data() + ir * shape.depth, packedB.data(),
+                                     tile + ir * c.rowStride + jr, c.rowStride, std::min(MR, mc - ir), nr, beta);
+            }
+            return;
+        }
+
+        workspace.resize(MC * NC);
+        GemmResult sums{workspace.data(), nc};
+        for(std::size_t i = 0; i < mc; i++)
+            for(std::size_t j = 0; j < nc; j++)
+                sums.data[i * nc + j] = tile[i * c.rowStride + j];
+        scaleResult(GemmShape{mc, nc, 0}, beta, sums);
+
+        for(std::size_t pc = 0; pc < shape.depth; pc += KC) {
+            std::size_t kc = std::min(KC, shape.depth - pc);
+            packA(a, ic, pc, mc, kc, alpha, packedA.data());
+            for(std::size_t jr = 0; jr < nc; jr += NR) {
+                std::size_t nr = std::min(NR, nc - jr);
+                packB(b, pc, jc + jr, kc, nr, packedB.data());
+                for(std::size_t ir = 0; ir < mc; ir += MR)
+                    microKernel(kc, packedA.data() + ir * kc, packedB.data(),
+                                sums.data + ir * nc + jr, nc, std::min(MR, mc - ir), nr);
+            }
+        }
+
+        for(std::size_t i = 0; i < mc; i++)
+            for(std::size_t j = 0; j < nc; j++)
+                tile[i * c.rowStride + j] = static_cast<float>(sums.data[i * nc + j]);
+    });
+}
+
+}
+
+void blockedGemm(GemmShape shape, double alpha, GemmOperand a, GemmOperand b, double beta, GemmResult c) {
+    gemmDriver(shape, alpha, a, b, beta, c);
+}
+
+void blockedGemm(GemmShape shape, double alpha, BasicGemmOperand<float> a, BasicGemmOperand<float> b,
+                 double beta, BasicGemmResult<float> c) {
+    gemmDriver(shape, alpha, a, b, beta, c);
+}
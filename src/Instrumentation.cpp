@@ -0,0 +1,227 @@
+#include "Instrumentation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "MemoryResource.hpp"
+
+namespace {
+
+constexpr const char* OPERATION_NAMES[INSTRUMENTED_OPERATION_COUNT] = {
+    "Vector::Vector",
+    "Vector(const Vector&)",
+    "Vector::operator*=",
+    "Vector::toString",
+    "Vector::magnitude",
+    "Vector::dot",
+    "Vector::angle",
+    "operator^(Vector, Vector)",
+    "Vector::getMatrix",
+    "Matrix::Matrix",
+    "Matrix(const Matrix&)",
+    "Matrix::operator*=",
+    "Matrix::toString",
+    "Matrix::transpose",
+    "Matrix::transposeInPlace",
+    "Matrix::rotate",
+    "Matrix::swapRows",
+    "Matrix::swapColumns",
+    "Matrix::save",
+    "Matrix::load",
+    "Matrix::getSubMatrix",
+    "Matrix::getRow",
+    "Matrix::getColumn",
+    "Matrix::getSubRow",
+    "Matrix::getSubColumn",
+    "Matrix::setRow",
+    "Matrix::setColumn",
+    "Matrix::setSubRow",
+    "Matrix::setSubColumn",
+    "Matrix::setSubMatrix",
+    "operator*(Matrix, Matrix)",
+    "gemm",
+    "SquareMatrix::identity",
+    "SquareMatrix::transpose",
+    "operator*(SquareMatrix, SquareMatrix)",
+    "strassenMultiply",
+    "operator^(SquareMatrix, std::size_t)",
+    "SquareMatrix::lu",
+    "SquareMatrix::determinant",
+    "SquareMatrix::inverse",
+    "SquareMatrix::solve",
+};
+
+std::atomic<TraceCallback> traceCallback{nullptr};
+std::atomic<void*> traceUserData{nullptr};
+
+#ifdef LINEAROBJECTS_INSTRUMENTATION
+
+struct OperationCounters {
+    std::atomic<std::uint64_t> calls{};
+    std::atomic<std::uint64_t> nanoseconds{};
+    std::atomic<std::uint64_t> flops{};
+    std::atomic<std::uint64_t> bytesAllocated{};
+    std::atomic<std::uint64_t> bytesCopied{};
+};
+
+struct ThreadCounters;
+
+// Counters of the running threads plus the totals of the threads that exited
+struct Registry {
+    std::mutex mutex{};
+    std::vector<ThreadCounters*> threads{};
+    InstrumentationSnapshot retired{};
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();    // Never destroyed: thread_local counters may outlive statics
+    return *instance;
+}
+
+void addTo(OperationStats& total, const OperationCounters& counters) {
+    total.calls += counters.calls.load(std::memory_order_relaxed);
+    total.nanoseconds += counters.nanoseconds.load(std::memory_order_relaxed);
+    total.flops += counters.flops.load(std::memory_order_relaxed);
+    total.bytesAllocated += counters.bytesAllocated.load(std::memory_order_relaxed);
+    total.bytesCopied += counters.bytesCopied.load(std::memory_order_relaxed);
+}
+
+// Written only by the owning thread; atomics so that snapshots and resets can read and clear them.
+struct ThreadCounters {
+    std::array<OperationCounters, INSTRUMENTED_OPERATION_COUNT> operations{};
+    std::size_t depth{};    // Operations currently running on this thread
+
+    ThreadCounters() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.threads.push_back(this);
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+    ~ThreadCounters() {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for(std::size_t i = 0; i < INSTRUMENTED_OPERATION_COUNT; i++)
+            addTo(shared.retired[i], operations[i]);
+        shared.threads.erase(std::remove(shared.threads.begin(), shared.threads.end(), this), shared.threads.end());
+    }
+};
+
+ThreadCounters& threadCounters() {
+    thread_local ThreadCounters counters;
+    return counters;
+}
+
+std::uint64_t now() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+#endif
+
+}
+
+const char* operationName(InstrumentedOperation operation) {
+    auto idx = static_cast<std::size_t>(operation);
+    return idx < INSTRUMENTED_OPERATION_COUNT ? OPERATION_NAMES[idx] : "unknown";
+}
+
+InstrumentationSnapshot instrumentationSnapshot() {
+    InstrumentationSnapshot snapshot{};
+#ifdef LINEAROBJECTS_INSTRUMENTATION
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    snapshot = shared.retired;
+    for(const ThreadCounters* thread : shared.threads)
+        for(std::size_t i = 0; i < INSTRUMENTED_OPERATION_COUNT; i++)
+            addTo(snapshot[i], thread->operations[i]);
+#endif
+    return snapshot;
+}
+
+void resetInstrumentation() {
+#ifdef LINEAROBJECTS_INSTRUMENTATION
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.retired = InstrumentationSnapshot{};
+    for(ThreadCounters* thread : shared.threads) {
+        for(OperationCounters& counters : thread->operations) {
+            counters.calls.store(0, std::memory_order_relaxed);
+            counters.nanoseconds.store(0, std::memory_order_relaxed);
+            counters.flops.store(0, std::memory_order_relaxed);
+            counters.bytesAllocated.store(0, std::memory_order_relaxed);
+            counters.bytesCopied.store(0, std::memory_order_relaxed);
+        }
+    }
+#endif
+}
+
+std::string instrumentationJson(const InstrumentationSnapshot& snapshot) {
+    std::ostringstream os;
+    os << "{\"operations\": [";
+    bool first = true;
+    for(std::size_t i = 0; i < INSTRUMENTED_OPERATION_COUNT; i++) {
+        const OperationStats& stats = snapshot[i];
+        if(stats.calls == 0)
+            continue;
+        os << (first ? "" : ", ") << "{\"name\": \"" << OPERATION_NAMES[i] << "\", \"calls\": " << stats.calls
+           << ", \"nanoseconds\": " << stats.nanoseconds << ", \"flops\": " << stats.flops
+           << ", \"bytes_allocated\": " << stats.bytesAllocated << ", \"bytes_copied\": " << stats.bytesCopied << "}";
+        first = false;
+    }
+    os << "]}";
+    return os.str();
+}
+
+void setTraceCallback(TraceCallback callback, void* userData) {
+    traceUserData.store(userData, std::memory_order_relaxed);
+    traceCallback.store(callback, std::memory_order_release);
+}
+
+#ifdef LINEAROBJECTS_INSTRUMENTATION
+
+// OperationScope
+
+// Constructors
+OperationScope::OperationScope(InstrumentedOperation op, std::uint64_t flopCount, std::uint64_t copiedBytes) noexcept
+    : operation(op), flops(flopCount), bytesCopied(copiedBytes), outermost(threadCounters().depth++ == 0) {
+    if(outermost) {
+        allocatedAtStart = threadBytesAllocated();
+        start = now();
+    }
+}
+
+// Destructor
+OperationScope::~OperationScope() {
+    ThreadCounters& counters = threadCounters();
+    counters.depth--;
+    if(!outermost)
+        return;
+
+    TraceEvent event;
+    event.operation = operation;
+    event.startNanoseconds = start;
+    event.stats.calls = 1;
+    event.stats.nanoseconds = now() - start;
+    event.stats.flops = flops;
+    event.stats.bytesAllocated = threadBytesAllocated() - allocatedAtStart;
+    event.stats.bytesCopied = bytesCopied;
+
+    OperationCounters& total = counters.operations[static_cast<std::size_t>(operation)];
+    total.calls.fetch_add(1, std::memory_order_relaxed);
+    total.nanoseconds.fetch_add(event.stats.nanoseconds, std::memory_order_relaxed);
+    total.flops.fetch_add(event.stats.flops, std::memory_order_relaxed);
+    total.bytesAllocated.fetch_add(event.stats.bytesAllocated, std::memory_order_relaxed);
+    total.bytesCopied.fetch_add(event.stats.bytesCopied, std::memory_order_relaxed);
+
+    if(TraceCallback callback = traceCallback.load(std::memory_order_acquire))
+        callback(event, traceUserData.load(std::memory_order_relaxed));
+}
+
+#endif
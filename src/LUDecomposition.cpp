@@ -0,0 +1,212 @@
+#include "LUDecomposition.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "Gemm.hpp"
+#include "VectorKernels.hpp"
+
+namespace {
+
+// Columns per panel; the panel is factored with row operations, everything right of it with the multiply kernel.
+constexpr std::size_t PANEL = 64;
+
+// Rows per block in the triangular solves; the solved rows are folded into the rest with the multiply kernel.
+constexpr std::size_t SOLVE_BLOCK = 64;
+
+// c -= a * b for row-major blocks: c is (rowCount x columnCount), a is (rowCount x depth)
+void subtractProduct(std::size_t rowCount, std::size_t columnCount, std::size_t depth,
+                     const double* a, std::size_t lda, const double* b, std::size_t ldb, double* c, std::size_t ldc) {
+    if(rowCount == 0 || columnCount == 0 || depth == 0)
+        return;
+    GemmShape shape{rowCount, columnCount, depth};
+    blockedGemm(shape, -1.0, GemmOperand{a, lda, 1}, GemmOperand{b, ldb, 1}, 1.0, GemmResult{c, ldc});
+}
+
+}
+
+// Constructors
+
+LUDecomposition::LUDecomposition(const SquareMatrix& matrix)
+    : factors(matrix), permutation(matrix.getDimension().rowCount) {
+    for(std::size_t i = 0; i < permutation.size(); i++)
+        permutation[i] = i;
+    factorize();
+}
+
+// Methods
+
+// Right-looking blocked LU. For each panel of columns [k, end):
+//   1. factor the tall panel [k, n) x [k, end) with partial pivoting, swapping whole rows (swapRows);
+//   2. U12 = L11^-1 A12 for the rows of the panel, right of it;
+//   3. A22 -= L21 * U12 for everything below and right of it (one multiply-kernel call).
+void LUDecomposition::factorize() {
+    const VectorKernels& kernels = activeVectorKernels();
+    MatrixView a = factors.view();
+    double* base = a.data();
+    std::size_t ld = a.getStride();
+    std::size_t n = permutation.size();
+    auto at = [&](std::size_t i, std::size_t j) -> double& { return base[i * ld + j]; };
+
+    for(std::size_t k = 0; k < n; k += PANEL) {
+        std::size_t end = std::min(n, k + PANEL);
+
+        for(std::size_t j = k; j < end; j++) {
+            std::size_t pivot = j;
+            for(std::size_t i = j + 1; i < n; i++)
+                if(std::fabs(at(i, j)) > std::fabs(at(pivot, j)))
+                    pivot = i;
+            if(at(pivot, j) == 0.0) {    // Nothing to eliminate with; U gets a zero on its diagonal
+                singular = true;
+                continue;
+            }
+            if(pivot != j) {
+                factors.swapRows(j, pivot);
+                std::swap(permutation[j], permutation[pivot]);
+                pivotSign = -pivotSign;
+            }
+
+            double inverse = 1.0 / at(j, j);
+            for(std::size_t i = j + 1; i < n; i++) {
+                at(i, j) *= inverse;
+                kernels.axpy(-at(i, j), &at(j, j + 1), &at(i, j + 1), end - j - 1);
+            }
+        }
+
+        if(end == n)
+            break;
+        for(std::size_t r = k + 1; r < end; r++)
+            for(std::size_t i = k; i < r; i++)
+                kernels.axpy(-at(r, i), &at(i, end), &at(r, end), n - end);
+        subtractProduct(n - end, n - end, end - k, &at(end, k), ld, &at(k, end), ld, &at(end, end), ld);
+    }
+}
+
+// Forward substitution with L, then back substitution with U, SOLVE_BLOCK rows at a time:
+// each block first subtracts the contribution of all rows already solved (one multiply-kernel call),
+// then solves its own small triangle with row operations.
+void LUDecomposition::solveInPlace(MatrixView rhs) const {
+    if(singular)
+        throw std::invalid_argument("Matrix is singular!");
+    if(!rhs.isRowMajor()) {      // The sweeps run over contiguous rows of the right-hand sides
+        Matrix rows(rhs);
+        solveInPlace(rows);
+        rhs = rows.view();
+        return;
+    }
+    const VectorKernels& kernels = activeVectorKernels();
+    ConstMatrixView lu = factors.view();
+    const double* base = lu.data();
+    std::size_t ld = lu.getStride();
+    double* x = rhs.data();
+    std::size_t ldx = rhs.getStride();
+    std::size_t n = permutation.size();
+    std::size_t m = rhs.getDimension().columnCount;
+    auto at = [&](std::size_t i, std::size_t j) { return base[i * ld + j]; };
+
+    for(std::size_t b = 0; b < n; b += SOLVE_BLOCK) {
+        std::size_t end = std::min(n, b + SOLVE_BLOCK);
+        subtractProduct(end - b, m, b, &base[b * ld], ld, x, ldx, x + b * ldx, ldx);
+        for(std::size_t i = b + 1; i < end; i++)
+            for(std::size_t k = b; k < i; k++)
+                kernels.axpy(-at(i, k), x + k * ldx, x + i * ldx, m);
+    }
+
+    for(std::size_t end = n; end > 0;) {
+        std::size_t b = end > SOLVE_BLOCK ? end - SOLVE_BLOCK : 0;
+        subtractProduct(end - b, m, n - end, &base[b * ld + end], ld, x + end * ldx, ldx, x + b * ldx, ldx);
+        for(std::size_t i = end; i-- > b;) {
+            for(std::size_t k = i + 1; k < end; k++)
+                kernels.axpy(-at(i, k), x + k * ldx, x + i * ldx, m);
+            kernels.scale(x + i * ldx, 1.0 / at(i, i), x + i * ldx, m);
+        }
+        end = b;
+    }
+}
+
+double LUDecomposition::determinant() const {
+    double result = pivotSign;
+    for(std::size_t i = 0; i < permutation.size(); i++)
+        result *= factors.element(i, i);
+    return result;
+}
+
+Vector LUDecomposition::solve(ConstVectorView rhs) const {
+    std::size_t n = permutation.size();
+    if(rhs.getDimension() != n)
+        throw std::invalid_argument("Vector should contain " + std::to_string(n) + " Elements");
+    if(singular)
+        throw std::invalid_argument("Matrix is singular!");
+
+    // A single right-hand side: one dot product per row of L and of U.
+    const VectorKernels& kernels = activeVectorKernels();
+    Vector result(n);
+    for(std::size_t i = 0; i < n; i++)
+        result[i] = rhs[permutation[i]];
+    VectorView x = result;
+    ConstMatrixView lu = factors.view();
+    for(std::size_t i = 1; i < n; i++)
+        x[i] -= kernels.dot(lu.data() + i * lu.getStride(), x.data(), i);
+    for(std::size_t i = n; i-- > 0;) {
+        const double* row = lu.data() + i * lu.getStride();
+        x[i] = (x[i] - kernels.dot(row + i + 1, x.data() + i + 1, n - i - 1)) / row[i];
+    }
+    return result;
+}
+
+Matrix LUDecomposition::solve(ConstMatrixView rhs) const {
+    std::size_t n = permutation.size();
+    if(rhs.getDimension().rowCount != n)
+        throw std::invalid_argument("Right-hand side should contain " + std::to_string(n) + " Rows");
+
+    Matrix result(n, rhs.getDimension().columnCount);
+    for(std::size_t i = 0; i < n; i++)
+        result[i] = rhs[permutation[i]];
+    solveInPlace(result);
+    return result;
+}
+
+SquareMatrix LUDecomposition::inverse() const {
+    std::size_t n = permutation.size();
+    SquareMatrix result(n);
+    for(std::size_t i = 0; i < n; i++)
+        result[i][permutation[i]] = 1.0;
+    solveInPlace(result);
+    return result;
+}
+
+SquareMatrix LUDecomposition::lower() const {
+    std::size_t n = permutation.size();
+    SquareMatrix result(n);
+    for(std::size_t i = 0; i < n; i++) {
+        for(std::size_t j = 0; j < i; j++)
+            result[i][j] = factors.element(i, j);
+        result[i][i] = 1.0;
+    }
+    return result;
+}
+
+SquareMatrix LUDecomposition::upper() const {
+    std::size_t n = permutation.size();
+    SquareMatrix result(n);
+    for(std::size_t i = 0; i < n; i++)
+        for(std::size_t j = i; j < n; j++)
+            result[i][j] = factors.element(i, j);
+    return result;
+}
+
+// Getters
+
+const SquareMatrix& LUDecomposition::getFactors() const {
+    return factors;
+}
+
+const std::vector<std::size_t>& LUDecomposition::getPermutation() const {
+    return permutation;
+}
+
+bool LUDecomposition::isSingular() const {
+    return singular;
+}
@@ -1,32 +1,41 @@
 #include "Matrix.hpp"
 
-bool MatrixSize::validate() const {
-    if( rowCount > 0 && columnCount > 0 )
-        return true;
-    return false;
-}
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "Gemm.hpp"
+#include "Instrumentation.hpp"
+#include "MatrixFile.hpp"
+#include "Transpose.hpp"
+#include "VectorKernels.hpp"
 
 // Constructors
 
-Matrix::Matrix(std::size_t rowCount, std::size_t columnCount) {
+template<typename T>
+BasicMatrix<T>::BasicMatrix(std::size_t rowCount, std::size_t columnCount) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixConstruct);
     size.rowCount = rowCount;
     size.columnCount = columnCount;
     if(!size.validate())
         throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
-    for(std::size_t i = 0 ; i < rowCount; i++)
-        data.emplace_back(columnCount);
+    stride = columnCount;
+    data.resize(rowCount * stride);
 }
 
-Matrix::Matrix(MatrixSize matSize) {
+template<typename T>
+BasicMatrix<T>::BasicMatrix(MatrixSize matSize) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixConstruct);
     if(!matSize.validate())
         throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
     size = matSize;
-    for(std::size_t i = 0; i < size.rowCount; i++)
-        data.emplace_back(size.columnCount);
+    stride = size.columnCount;
+    data.resize(size.rowCount * stride);
 }
 
-Matrix::Matrix(std::initializer_list<std::initializer_list<double>> matrixRows) {
-
+template<typename T>
+BasicMatrix<T>::BasicMatrix(std::initializer_list<std::initializer_list<T>> matrixRows) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixConstruct);
     size.rowCount = matrixRows.size();
     if( size.rowCount == 0 )
         throw std::invalid_argument("Condition didn't match (rowCount > 0)");
@@ -44,13 +53,15 @@ Matrix::Matrix(std::initializer_list<std::initializer_list<double>> matrixRows)
             throw std::invalid_argument("Every row should contain same amount of elements!");
 
         // Initialization
-        Vector result(row);
-        data.push_back(result);
+        data.insert(data.end(), row.begin(), row.end());
     }
+    stride = size.columnCount;
 
 }
 
-Matrix::Matrix(const std::vector<Vector>& matrixRows) {
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const std::vector<BasicVector<T>>& matrixRows) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixConstruct);
     size.rowCount = matrixRows.size();
     if(size.rowCount == 0)
         throw std::invalid_argument("Condition didn't match (rowCount > 0)");
@@ -59,14 +70,19 @@ Matrix::Matrix(const std::vector<Vector>& matrixRows) {
     if(size.columnCount == 0)
         throw std::invalid_argument("Condition didn't match (columnCount > 0)");
 
+    stride = size.columnCount;
+    data.reserve(size.rowCount * stride);
     for(const auto& i: matrixRows) {
         if(i.getDimension() != size.columnCount)
             throw std::invalid_argument("Every row should contain same amount of elements!");
-        data.push_back(i);
+        for(std::size_t j = 0; j < size.columnCount; j++)
+            data.push_back(i[j]);
     }
 }
 
-Matrix::Matrix(const std::vector<std::vector<double>>& matrixRows) {
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const std::vector<std::vector<T>>& matrixRows) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixConstruct);
     size.rowCount = matrixRows.size();
     if(size.rowCount == 0)
         throw std::invalid_argument("Condition didn't match (rowCount > 0)");
@@ -75,255 +91,580 @@ Matrix::Matrix(const std::vector<std::vector<double>>& matrixRows) {
     if(size.columnCount == 0)
         throw std::invalid_argument("Condition didn't match (columnCount > 0)");
 
+    stride = size.columnCount;
+    data.reserve(size.rowCount * stride);
     for(const auto& i: matrixRows) {
         if(i.size() != size.columnCount)
             throw std::invalid_argument("Every row should contain same amount of elements!");
-        data.emplace_back(i);
+        data.insert(data.end(), i.begin(), i.end());
     }
 }
 
-Matrix::Matrix(const Matrix& matrix) {
-    size.rowCount = matrix.size.rowCount;
-    size.columnCount = matrix.size.columnCount;
-    data = matrix.data;
+template<typename T>
+BasicMatrix<T>::BasicMatrix(std::size_t rowCount, std::size_t columnCount, std::pmr::memory_resource* resource)
+    : data(AlignedAllocator<T>(resource)) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixConstruct);
+    size.rowCount = rowCount;
+    size.columnCount = columnCount;
+    if(!size.validate())
+        throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
+    stride = columnCount;
+    data.resize(rowCount * stride);
+}
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix(std::size_t rowCount, std::size_t columnCount, BasicAlignedBuffer<T>&& elements) : data(std::move(elements)) {
+    size.rowCount = rowCount;
+    size.columnCount = columnCount;
+    if(!size.validate())
+        throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
+    if(data.size() != rowCount * columnCount)
+        throw std::invalid_argument("Buffer should contain " + std::to_string(rowCount * columnCount) + " Elements");
+    stride = columnCount;
+}
+
+template<typename T>
+BasicMatrix<T>::BasicMatrix(BasicMatrixView<const T> view) {
+    size = view.getDimension();
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixConstruct, 0, size.rowCount * size.columnCount * sizeof(T));
+    stride = size.columnCount;
+    data.resize(size.rowCount * stride);
+    assign(view, 0, size.rowCount);
 }
 
-Matrix::Matrix(const Matrix&& matrix) noexcept {
+template<typename T>
+BasicMatrix<T>::BasicMatrix(const BasicMatrix& matrix) : MatrixExpression<BasicMatrix<T>>() {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixCopy, 0, matrix.data.size() * sizeof(T));
     size.rowCount = matrix.size.rowCount;
     size.columnCount = matrix.size.columnCount;
+    stride = matrix.stride;
     data = matrix.data;
 }
 
-Matrix& Matrix::operator=(const Matrix& matrix) {
+template<typename T>
+BasicMatrix<T>::BasicMatrix(BasicMatrix&& matrix) noexcept : MatrixExpression<BasicMatrix<T>>(), data(std::move(matrix.data)) {
+    size = std::exchange(matrix.size, MatrixSize());
+    stride = std::exchange(matrix.stride, 0);
+}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(const BasicMatrix& matrix) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixCopy, 0, matrix.data.size() * sizeof(T));
     size = matrix.size;
+    stride = matrix.stride;
     data = matrix.data;
     return *this;
 }
 
-Matrix& Matrix::operator=(Matrix &&matrix) noexcept {
-    size = matrix.size;
-    data = matrix.data;
+// As for Vector, the buffer is stolen only when both matrices allocate from equal resources
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator=(BasicMatrix &&matrix) {
+    if(data.get_allocator() != matrix.data.get_allocator())
+        return *this = matrix;
+    size = std::exchange(matrix.size, MatrixSize());
+    stride = std::exchange(matrix.stride, 0);
+    data = std::move(matrix.data);
+    return *this;
+}
+
+// Compound Assignment
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::operator*=(double coeff) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixScale, size.rowCount * size.columnCount);
+    if constexpr(std::is_same_v<T, double>) {
+        const VectorKernels& kernels = activeVectorKernels();
+        for(std::size_t i = 0; i < size.rowCount; i++)
+            kernels.scale(rowPointer(i), coeff, rowPointer(i), size.columnCount);
+    } else {
+        view() *= coeff;
+    }
     return *this;
 }
 
 // Methods
 
-std::string Matrix::toString() const {
+template<typename T>
+std::string BasicMatrix<T>::toString() const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixToString);
     std::ostringstream os;
     os << *this;
     return os.str();
 }
 
-Matrix& Matrix::transpose() {
-    Matrix result(size.columnCount, size.rowCount);
-    for(std::size_t i = 0; i < size.rowCount; i++) {
-        for(std::size_t j = 0; j < size.columnCount; j++) {
-            result[j][i] = data[i][j];
-        }
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::transpose() {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixTranspose, 0, size.rowCount * size.columnCount * sizeof(T));
+    // A single row or column keeps its element order, only the shape changes.
+    if(size.rowCount > 1 && size.columnCount > 1) {
+        BasicAlignedBuffer<T> result(size.rowCount * size.columnCount, data.get_allocator());   // Same resource, so the move below adopts it
+        transposeOutOfPlace(size.rowCount, size.columnCount, data.data(), stride, result.data(), size.rowCount);
+        data = std::move(result);
     }
-    *this = result;
+    std::swap(size.rowCount, size.columnCount);
+    stride = size.columnCount;
     return *this;
 }
 
-Matrix& Matrix::swapRows(std::size_t idx1, std::size_t idx2) {
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::transposeInPlace() {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixTransposeInPlace, 0, size.rowCount * size.columnCount * sizeof(T));
+    ::transposeInPlace(size.rowCount, size.columnCount, data.data());
+    std::swap(size.rowCount, size.columnCount);
+    stride = size.columnCount;
+    return *this;
+}
+
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::swapRows(std::size_t idx1, std::size_t idx2) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSwapRows, 0, 2 * size.columnCount * sizeof(T));
     if( idx1 >= size.rowCount || idx2 >= size.rowCount)
         throw std::invalid_argument("Condition didn't match ( idx1 < rowCount && idx2 < rowCount )");
-    std::swap(data[idx1], data[idx2]);
+    std::swap_ranges(rowPointer(idx1), rowPointer(idx1) + size.columnCount, rowPointer(idx2));
     return *this;
 }
 
-Matrix& Matrix::swapColumns(std::size_t idx1, std::size_t idx2) {
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::swapColumns(std::size_t idx1, std::size_t idx2) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSwapColumns, 0, 2 * size.rowCount * sizeof(T));
     if(idx1 >= size.columnCount || idx2 >= size.columnCount)
         throw std::invalid_argument("Condition didn't match ( idx1 < columnCount && idx2 < columnCount");
     for(std::size_t i = 0; i < size.rowCount; i++)
-        std::swap(data[i][idx1], data[i][idx2]);
+        std::swap(data[i * stride + idx1], data[i * stride + idx2]);
     return *this;
 }
 
-Matrix& Matrix::rotate()
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::rotate()
 {
-    for(std::size_t i = 0; i < size.rowCount/2; i++)
-        swapRows(i, size.rowCount-i-1);
-    return transpose();
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixRotate, 0, size.rowCount * size.columnCount * sizeof(T));
+    rotateInPlace(size.rowCount, size.columnCount, data.data());
+    std::swap(size.rowCount, size.columnCount);
+    stride = size.columnCount;
+    return *this;
+}
+
+template<typename T>
+void BasicMatrix<T>::save(const std::string& path) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSave, 0, size.rowCount * size.columnCount * sizeof(T));
+    if constexpr(std::is_same_v<T, double>)
+        saveMatrix(path, *this);
+    else
+        saveMatrix(path, Matrix(*this));
+}
+
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::load(const std::string& path) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixLoad);
+    if constexpr(std::is_same_v<T, double>)
+        return loadMatrix(path);
+    else
+        return BasicMatrix(loadMatrix(path));
 }
 
-// Getters
+// Getters (owning copies of the views below)
 
-Matrix Matrix::getSubMatrix(std::size_t rowStart, std::size_t rowEnd,
+template<typename T>
+BasicMatrix<T> BasicMatrix<T>::getSubMatrix(std::size_t rowStart, std::size_t rowEnd,
                             std::size_t columnStart, std::size_t columnEnd) const {
-    if(rowEnd < rowStart || rowEnd >= size.rowCount)
-        throw std::invalid_argument("Condition didn't match (rowStart <= rowEnd < rowCount)");
-    if(columnEnd < columnStart || columnEnd >= size.columnCount)
-        throw std::invalid_argument("Condition didn't match (columnStart <= columnEnd < columnCount)");
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixGetSubMatrix, 0,
+                             (rowEnd - rowStart + 1) * (columnEnd - columnStart + 1) * sizeof(T));
+    return BasicMatrix(subMatrix(rowStart, rowEnd, columnStart, columnEnd));
+}
 
-    std::vector<Vector> newRows{};
+template<typename T>
+BasicVector<T> BasicMatrix<T>::getRow(std::size_t idx) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixGetRow, 0, size.columnCount * sizeof(T));
+    return row(idx);
+}
 
-    for(std::size_t i = rowStart, k = 0; i <= rowEnd; i++, k++)
-        newRows.push_back(getSubRow(i, columnStart, columnEnd));
+template<typename T>
+BasicVector<T> BasicMatrix<T>::getColumn(std::size_t idx) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixGetColumn, 0, size.rowCount * sizeof(T));
+    return column(idx);
+}
 
-    return Matrix(newRows);
+template<typename T>
+BasicVector<T> BasicMatrix<T>::getSubRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixGetSubRow, 0, (columnEnd - columnStart + 1) * sizeof(T));
+    return subRow(idx, columnStart, columnEnd);
 }
 
-Vector Matrix::getRow(std::size_t idx) const {
-    if( idx >= size.rowCount)
-        throw std::invalid_argument("Index out of bound");
-    return data[idx];
+template<typename T>
+BasicVector<T> BasicMatrix<T>::getSubColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixGetSubColumn, 0, (rowEnd - rowStart + 1) * sizeof(T));
+    return subColumn(idx, rowStart, rowEnd);
 }
 
-Vector Matrix::getColumn(std::size_t idx) const {
-    if(idx >= size.columnCount)
-        throw std::invalid_argument("Index out of bound");
+template<typename T>
+std::pmr::memory_resource* BasicMatrix<T>::getMemoryResource() const {
+    return data.get_allocator().getResource();
+}
 
-    Vector result(size.rowCount);
-    for(std::size_t i = 0; i < size.rowCount; i++)
-        result[i] = data[i][idx];
-    return result;
+// Views
+
+template<typename T>
+BasicMatrixView<T> BasicMatrix<T>::view() {
+    return BasicMatrixView<T>(data.data(), size.rowCount, size.columnCount, stride);
 }
 
-Vector Matrix::getSubRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd) const {
-    if(columnStart > columnEnd || columnEnd >= size.columnCount)
-        throw std::invalid_argument("Condition didn't match (columnStart <= columnEnd < columnCount)");
-    if( idx >= size.rowCount)
-        throw std::invalid_argument("Index out of bound");
+template<typename T>
+BasicMatrixView<const T> BasicMatrix<T>::view() const {
+    return BasicMatrixView<const T>(data.data(), size.rowCount, size.columnCount, stride);
+}
 
-    Vector subRow(columnEnd-columnStart+1);
-    for(std::size_t i = columnStart, j=0; i <= columnEnd; i++, j++)
-        subRow[j] = data[idx][i];
-    return subRow;
+template<typename T>
+BasicVectorView<T> BasicMatrix<T>::row(std::size_t idx) {
+    return view().row(idx);
 }
 
-Vector Matrix::getSubColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd) const {
-    if(rowStart > rowEnd || rowEnd >= size.rowCount)
-        throw std::invalid_argument("Condition didn't match (rowStart <= rowEnd < rowCount)");
-    if( idx >= size.columnCount)
-        throw std::invalid_argument("Index out of bound");
+template<typename T>
+BasicVectorView<const T> BasicMatrix<T>::row(std::size_t idx) const {
+    return view().row(idx);
+}
+
+template<typename T>
+BasicVectorView<T> BasicMatrix<T>::column(std::size_t idx) {
+    return view().column(idx);
+}
+
+template<typename T>
+BasicVectorView<const T> BasicMatrix<T>::column(std::size_t idx) const {
+    return view().column(idx);
+}
+
+template<typename T>
+BasicVectorView<T> BasicMatrix<T>::subRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd) {
+    BasicMatrixView<T> block = subMatrix(idx, idx, columnStart, columnEnd);
+    return block.row(0);
+}
+
+template<typename T>
+BasicVectorView<const T> BasicMatrix<T>::subRow(std::size_t idx, std::size_t columnStart, std::size_t columnEnd) const {
+    BasicMatrixView<const T> block = subMatrix(idx, idx, columnStart, columnEnd);
+    return block.row(0);
+}
 
-    Vector subColumn(rowEnd-rowStart+1);
-    for(std::size_t i = rowStart, j=0; i <= rowEnd; i++, j++)
-        subColumn[j] = data[i][idx];
-    return subColumn;
+template<typename T>
+BasicVectorView<T> BasicMatrix<T>::subColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd) {
+    BasicMatrixView<T> block = subMatrix(rowStart, rowEnd, idx, idx);
+    return block.column(0);
 }
 
-const MatrixSize& Matrix::getDimension() const {
-    return size;
+template<typename T>
+BasicVectorView<const T> BasicMatrix<T>::subColumn(std::size_t idx, std::size_t rowStart, std::size_t rowEnd) const {
+    BasicMatrixView<const T> block = subMatrix(rowStart, rowEnd, idx, idx);
+    return block.column(0);
+}
+
+template<typename T>
+BasicMatrixView<T> BasicMatrix<T>::subMatrix(std::size_t rowStart, std::size_t rowEnd,
+                             std::size_t columnStart, std::size_t columnEnd) {
+    return view().subMatrix(rowStart, rowEnd, columnStart, columnEnd);
+}
+
+template<typename T>
+BasicMatrixView<const T> BasicMatrix<T>::subMatrix(std::size_t rowStart, std::size_t rowEnd,
+                                  std::size_t columnStart, std::size_t columnEnd) const {
+    return view().subMatrix(rowStart, rowEnd, columnStart, columnEnd);
+}
+
+template<typename T>
+BasicMatrixView<T> BasicMatrix<T>::transposed() {
+    return view().transposed();
+}
+
+template<typename T>
+BasicMatrixView<const T> BasicMatrix<T>::transposed() const {
+    return view().transposed();
 }
 
 // Setters
 
-Matrix& Matrix::setRow(std::size_t idx, const Vector& row) {
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::setRow(std::size_t idx, const BasicVector<T>& row) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSetRow, 0, row.getDimension() * sizeof(T));
     if(row.getDimension() != size.columnCount)
         throw std::invalid_argument("Vector should contain " + std::to_string(size.columnCount) + " Elements");
     if(idx >= size.rowCount)
         throw std::invalid_argument("Index out of bound");
 
-    data[idx] = row;
+    for(std::size_t j = 0; j < size.columnCount; j++)
+        data[idx * stride + j] = row[j];
     return *this;
 }
 
-Matrix& Matrix::setColumn(std::size_t idx, const Vector& column) {
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::setColumn(std::size_t idx, const BasicVector<T>& column) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSetColumn, 0, column.getDimension() * sizeof(T));
     if(column.getDimension() != size.rowCount)
         throw std::invalid_argument("Vector should contain " + std::to_string(size.rowCount) + " Elements");
     if(idx >= size.columnCount)
         throw std::invalid_argument("Index out of bound");
 
     for(std::size_t i = 0; i < size.rowCount; i++)
-        data[i][idx] = column[i];
+        data[i * stride + idx] = column[i];
+
+    return *this;
+}
+
+// One element per row, so a chunk of rows touches as many cache lines as it has rows
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::setColumn(ExecutionPolicy policy, std::size_t idx, const BasicVector<T>& column) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSetColumn, 0, column.getDimension() * sizeof(T));
+    if(column.getDimension() != size.rowCount)
+        throw std::invalid_argument("Vector should contain " + std::to_string(size.rowCount) + " Elements");
+    if(idx >= size.columnCount)
+        throw std::invalid_argument("Index out of bound");
+
+    forEachChunk(policy, size.rowCount, EXECUTION_CHUNK, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        for(std::size_t i = rowBegin; i < rowEnd; i++)
+            data[i * stride + idx] = column.element(i);
+    });
 
     return *this;
 }
 
-Matrix& Matrix::setSubRow(std::size_t idx, std::size_t columnStart, const Vector &subRow) {
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::setSubRow(std::size_t idx, std::size_t columnStart, const BasicVector<T> &subRow) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSetSubRow, 0, subRow.getDimension() * sizeof(T));
     if(subRow.getDimension() > size.columnCount - columnStart)
         throw std::invalid_argument("Condition didn't match ( subRow.getDimension() <= columnCount - columnStart )");
     if(idx >= size.rowCount)
         throw std::invalid_argument("Index out of bound");
 
     for(std::size_t j = 0; j < subRow.getDimension(); j++)
-        data[idx][j + columnStart] = subRow[j];
+        data[idx * stride + j + columnStart] = subRow[j];
 
     return *this;
 }
 
-Matrix& Matrix::setSubColumn(std::size_t idx, std::size_t rowStart, const Vector &subColumn) {
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::setSubColumn(std::size_t idx, std::size_t rowStart, const BasicVector<T> &subColumn) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSetSubColumn, 0, subColumn.getDimension() * sizeof(T));
     if(subColumn.getDimension() > size.rowCount - rowStart)
         throw std::invalid_argument("Condition didn't match ( subColumn.getDimension() <= rowCount - rowStart )");
     if(idx >= size.columnCount)
         throw std::invalid_argument("Index out of bound");
 
     for(std::size_t j = 0; j < subColumn.getDimension(); j++)
-        data[j + rowStart][idx] = subColumn[j];
+        data[(j + rowStart) * stride + idx] = subColumn[j];
 
     return *this;
 }
 
-Matrix& Matrix::setSubMatrix(std::size_t rowStart, std::size_t columnStart, const Matrix &matrix) {
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::setSubMatrix(std::size_t rowStart, std::size_t columnStart, const BasicMatrix &matrix) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSetSubMatrix, 0, matrix.size.rowCount * matrix.size.columnCount * sizeof(T));
     if(matrix.size.rowCount > size.rowCount - rowStart)
         throw std::invalid_argument("Condition didn't match ( matrix.rowCount <= rowCount - rowStart )");
     if(matrix.size.columnCount > size.columnCount - columnStart)
         throw std::invalid_argument("Condition didn't match ( matrix.columnCount <= columnCount - columnStart )");
 
     for(std::size_t i = 0; i < matrix.size.rowCount; i++)
-        setSubRow(i + rowStart, columnStart, matrix[i]);
+        std::copy(matrix.rowPointer(i), matrix.rowPointer(i) + matrix.size.columnCount,
+                  rowPointer(i + rowStart) + columnStart);
 
     return *this;
 }
 
-// Friend Operators
+template<typename T>
+BasicMatrix<T>& BasicMatrix<T>::setSubMatrix(ExecutionPolicy policy, std::size_t rowStart, std::size_t columnStart,
+                                             const BasicMatrix &matrix) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixSetSubMatrix, 0, matrix.size.rowCount * matrix.size.columnCount * sizeof(T));
+    if(matrix.size.rowCount > size.rowCount - rowStart)
+        throw std::invalid_argument("Condition didn't match ( matrix.rowCount <= rowCount - rowStart )");
+    if(matrix.size.columnCount > size.columnCount - columnStart)
+        throw std::invalid_argument("Condition didn't match ( matrix.columnCount <= columnCount - columnStart )");
+
+    forEachChunk(policy, matrix.size.rowCount, chunkRows(matrix.size.columnCount),
+                 [&](std::size_t rowBegin, std::size_t rowEnd) {
+        for(std::size_t i = rowBegin; i < rowEnd; i++)
+            std::copy(matrix.rowPointer(i), matrix.rowPointer(i) + matrix.size.columnCount,
+                      rowPointer(i + rowStart) + columnStart);
+    });
 
-std::ostream &operator<<(std::ostream& os, const Matrix& matrix) {
-    for(std::size_t i = 0; i < matrix.size.rowCount; i++)
-        os << matrix.data[i];
-    return os;
+    return *this;
 }
 
-Matrix operator*(const Matrix &lhs, const Matrix &rhs) {
-    if(lhs.size.columnCount != rhs.size.rowCount)
-        throw std::invalid_argument("Left matrix's column count should be equal to right matrix's row count!");
+// Class Operators
 
-    Matrix result(lhs.size.rowCount, rhs.size.columnCount);
-    for(std::size_t i = 0; i < lhs.size.rowCount; i++) {
-        for(std::size_t j = 0; j < rhs.size.columnCount; j++) {
-            result[i][j] = lhs.getRow(i) * rhs.getColumn(j);
-        }
+template<typename T>
+BasicMatrix<T>::operator BasicMatrixView<T>() {
+    return view();
+}
+
+template<typename T>
+BasicMatrix<T>::operator BasicMatrixView<const T>() const {
+    return view();
+}
+
+template class BasicMatrix<double>;
+template class BasicMatrix<float>;
+template class BasicMatrix<int>;
+
+// Free Functions
+
+namespace {
+
+void checkProductShape(const MatrixSize& aSize, const MatrixSize& bSize, const MatrixSize& cSize) {
+    if(aSize.columnCount != bSize.rowCount)
+        throw std::invalid_argument("Left matrix's column count should be equal to right matrix's row count!");
+    if(cSize.rowCount != aSize.rowCount || cSize.columnCount != bSize.columnCount)
+        throw std::invalid_argument("Result matrix should be " + std::to_string(aSize.rowCount) + "x" +
+                                    std::to_string(bSize.columnCount));
+}
+
+// alpha * sum + beta * c for the int gemm(): exact when alpha and beta are integers (below 2^31 in magnitude,
+// so beta * c cannot overflow), otherwise computed in double and rounded to nearest. Throws when the result
+// does not fit in an int.
+int combineInt(double alpha, long long sum, double beta, int c) {
+    constexpr double COEFFICIENT_LIMIT = 2147483648.0;
+    constexpr long long LIMIT = std::numeric_limits<long long>::max();
+    const std::overflow_error overflow("Product element does not fit in an int");
+
+    if(std::trunc(alpha) == alpha && std::trunc(beta) == beta &&
+       std::fabs(alpha) < COEFFICIENT_LIMIT && std::fabs(beta) < COEFFICIENT_LIMIT) {
+        auto a = static_cast<long long>(alpha);
+        long long bc = static_cast<long long>(beta) * c;
+        if(a != 0 && (sum > LIMIT / std::llabs(a) || sum < -(LIMIT / std::llabs(a))))
+            throw overflow;
+        long long scaled = a * sum;
+        if((bc > 0 && scaled > LIMIT - bc) || (bc < 0 && scaled < -LIMIT - bc))
+            throw overflow;
+        long long value = scaled + bc;
+        if(value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max())
+            throw overflow;
+        return static_cast<int>(value);
     }
 
-    return result;
+    return roundToScalar<int>(alpha * static_cast<double>(sum) + beta * c);
 }
 
-Matrix operator*(const Matrix &lhs, double coeff) {
-    return coeff * lhs;
+// sum += product, counting wraps of the long long sum in carry (in units of 2^64), so the exact value
+// sum + carry * 2^64 survives intermediate overflows that would otherwise wrap back into int range.
+// A product of two ints always fits in a long long.
+void addProduct(long long& sum, long long& carry, long long product) {
+    constexpr long long LIMIT = std::numeric_limits<long long>::max();
+    if(product > 0 && sum > LIMIT - product)
+        carry++;
+    else if(product < 0 && sum < -LIMIT - 1 - product)
+        carry--;
+    sum = static_cast<long long>(static_cast<unsigned long long>(sum) + static_cast<unsigned long long>(product));
 }
 
-Matrix operator*(double coeff, const Matrix &lhs) {
-    Matrix result(lhs);
-    for(std::size_t i = 0; i < lhs.size.rowCount; i++)
-        for(std::size_t j = 0; j < lhs.size.columnCount; j++)
-            result[i][j] *= coeff;
+template<typename T>
+BasicMatrix<T> multiply(BasicMatrixView<const T> lhs, BasicMatrixView<const T> rhs) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::MatrixMultiply,
+                             2 * lhs.getDimension().rowCount * lhs.getDimension().columnCount * rhs.getDimension().columnCount);
+    if(lhs.getDimension().columnCount != rhs.getDimension().rowCount)
+        throw std::invalid_argument("Left matrix's column count should be equal to right matrix's row count!");
+
+    BasicMatrix<T> result(lhs.getDimension().rowCount, rhs.getDimension().columnCount);
+    gemm(1.0, lhs, rhs, 0.0, result.view());
     return result;
 }
 
-Matrix operator+(const Matrix &lhs, const Matrix &rhs) {
-    if(lhs.size.rowCount != rhs.size.rowCount || lhs.size.columnCount != rhs.size.columnCount)
-        throw std::invalid_argument("Addition of matrices with different sizes are not defined!");
-
-    Matrix result(lhs);
-    for(std::size_t i = 0; i < lhs.size.rowCount; i++)
-        for(std::size_t j = 0; j < lhs.size.columnCount; j++)
-            result[i][j] += rhs[i][j];
+}
 
-    return result;
+Matrix operator*(ConstMatrixView lhs, ConstMatrixView rhs) {
+    return multiply(lhs, rhs);
 }
 
-// Class Operators
+FloatMatrix operator*(BasicMatrixView<const float> lhs, BasicMatrixView<const float> rhs) {
+    return multiply(lhs, rhs);
+}
 
-Vector& Matrix::operator[](std::size_t idx) {
-    if(idx >= size.rowCount)
-        throw std::invalid_argument("Index out of bound");
-    return data[idx];
+IntMatrix operator*(BasicMatrixView<const int> lhs, BasicMatrixView<const int> rhs) {
+    return multiply(lhs, rhs);
 }
 
-const Vector& Matrix::operator[](std::size_t idx) const {
-    if(idx >= size.rowCount)
-        throw std::invalid_argument("Index out of bound");
-    return data[idx];
+void gemm(double alpha, ConstMatrixView a, ConstMatrixView b, double beta, MatrixView c) {
+    const MatrixSize& aSize = a.getDimension();
+    const MatrixSize& bSize = b.getDimension();
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::Gemm, 2 * aSize.rowCount * aSize.columnCount * bSize.columnCount);
+    checkProductShape(aSize, bSize, c.getDimension());
+
+    // The kernel reads A and B while writing C, so an overlapping C is computed out of place.
+    // It writes row-major results: a transposed C is filled as C^T = B^T A^T.
+    if(overlaps(ConstMatrixView(c), a) || overlaps(ConstMatrixView(c), b) || (!c.isRowMajor() && c.getStride() != 1)) {
+        Matrix result(c);
+        gemm(alpha, a, b, beta, result.view());
+        c = result.view();
+        return;
+    }
+    if(!c.isRowMajor()) {
+        gemm(alpha, b.transposed(), a.transposed(), beta, c.transposed());
+        return;
+    }
+
+    // Operands of any layout go straight to the kernel, which reads them through both strides
+    blockedGemm({aSize.rowCount, bSize.columnCount, aSize.columnCount}, alpha,
+                {a.data(), a.getStride(), a.getColumnStride()}, {b.data(), b.getStride(), b.getColumnStride()},
+                beta, {c.data(), c.getStride()});
+}
+
+// Mixed precision: the kernel widens A and B to double while packing them and accumulates each tile of C
+// in double before rounding it to float (see Gemm.hpp). Overlaps and transposed C as in the double gemm().
+void gemm(double alpha, BasicMatrixView<const float> a, BasicMatrixView<const float> b,
+          double beta, BasicMatrixView<float> c) {
+    const MatrixSize& aSize = a.getDimension();
+    const MatrixSize& bSize = b.getDimension();
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::Gemm, 2 * aSize.rowCount * aSize.columnCount * bSize.columnCount);
+    checkProductShape(aSize, bSize, c.getDimension());
+
+    if(overlaps(BasicMatrixView<const float>(c), a) || overlaps(BasicMatrixView<const float>(c), b) ||
+       (!c.isRowMajor() && c.getStride() != 1)) {
+        FloatMatrix result(c);
+        gemm(alpha, a, b, beta, result.view());
+        c = result.view();
+        return;
+    }
+    if(!c.isRowMajor()) {
+        gemm(alpha, b.transposed(), a.transposed(), beta, c.transposed());
+        return;
+    }
+
+    blockedGemm({aSize.rowCount, bSize.columnCount, aSize.columnCount}, alpha,
+                BasicGemmOperand<float>{a.data(), a.getStride(), a.getColumnStride()},
+                BasicGemmOperand<float>{b.data(), b.getStride(), b.getColumnStride()},
+                beta, BasicGemmResult<float>{c.data(), c.getStride()});
+}
+
+// Row by row (i-k-j), each row accumulated exactly (see addProduct()) before alpha and beta are applied
+// (see combineInt()).
+void gemm(double alpha, BasicMatrixView<const int> a, BasicMatrixView<const int> b,
+          double beta, BasicMatrixView<int> c) {
+    const MatrixSize& aSize = a.getDimension();
+    const MatrixSize& bSize = b.getDimension();
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::Gemm, 2 * aSize.rowCount * aSize.columnCount * bSize.columnCount);
+    checkProductShape(aSize, bSize, c.getDimension());
+
+    if(overlaps(BasicMatrixView<const int>(c), a) || overlaps(BasicMatrixView<const int>(c), b)) {
+        IntMatrix result(c);
+        gemm(alpha, a, b, beta, result.view());
+        c = result.view();
+        return;
+    }
+
+    std::vector<long long> sums(bSize.columnCount);
+    std::vector<long long> carries(bSize.columnCount);
+    for(std::size_t i = 0; i < aSize.rowCount; i++) {
+        std::fill(sums.begin(), sums.end(), 0LL);
+        std::fill(carries.begin(), carries.end(), 0LL);
+        for(std::size_t p = 0; p < aSize.columnCount; p++) {
+            long long left = a.element(i, p);
+            if(left == 0)
+                continue;
+            BasicVectorView<const int> right = b.row(p);
+            for(std::size_t j = 0; j < bSize.columnCount; j++)
+                addProduct(sums[j], carries[j], left * right.element(j));
+        }
+        BasicVectorView<int> row = c.row(i);
+        for(std::size_t j = 0; j < bSize.columnCount; j++) {
+            if(carries[j] != 0)     // |A * B| >= 2^63
+                throw std::overflow_error("Product element does not fit in an int");
+            row[j] = combineInt(alpha, sums[j], beta, beta == 0.0 ? 0 : row[j]);
+        }
+    }
 }
@@ -0,0 +1,372 @@
+#include "MatrixFile.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr char MAGIC[8] = "LOBJMAT";
+constexpr std::uint32_t ELEMENT_DOUBLE = 1;
+constexpr std::uint32_t ENDIAN_MARK = 0x01020304;
+constexpr std::uint32_t PAYLOAD_ALIGNMENT = 64;
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t elementType;
+    std::uint32_t endianMark;
+    std::uint32_t alignment;
+    std::uint64_t rowCount;
+    std::uint64_t columnCount;
+    std::uint64_t payloadOffset;
+    char reserved[16];
+};
+static_assert(sizeof(FileHeader) == 64, "Matrix file header should be 64 bytes");
+
+template<typename T>
+T byteSwapped(T value) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for(std::size_t i = 0; i < sizeof(T) / 2; i++)
+        std::swap(bytes[i], bytes[sizeof(T) - 1 - i]);
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+// Validates the header against a file of fileSize bytes and returns it in native byte order.
+// swapped reports whether the file was written with the other byte order.
+FileHeader parseHeader(FileHeader header, std::uint64_t fileSize, const std::string& path, bool& swapped) {
+    if(std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+        throw std::invalid_argument("Not a matrix file: " + path);
+    swapped = header.endianMark == byteSwapped(ENDIAN_MARK);
+    if(!swapped && header.endianMark != ENDIAN_MARK)
+        throw std::invalid_argument("Unknown byte order in matrix file: " + path);
+    if(swapped) {
+        header.version = byteSwapped(header.version);
+        header.elementType = byteSwapped(header.elementType);
+        header.alignment = byteSwapped(header.alignment);
+        header.rowCount = byteSwapped(header.rowCount);
+        header.columnCount = byteSwapped(header.columnCount);
+        header.payloadOffset = byteSwapped(header.payloadOffset);
+    }
+
+    if(header.version != MATRIX_FILE_VERSION)
+        throw std::invalid_argument("Unsupported matrix file version " + std::to_string(header.version) + ": " + path);
+    if(header.elementType != ELEMENT_DOUBLE)
+        throw std::invalid_argument("Unsupported element type in matrix file: " + path);
+    if(header.rowCount == 0 || header.columnCount == 0)
+        throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
+    if(header.payloadOffset < sizeof(FileHeader) || header.payloadOffset % sizeof(double) != 0)
+        throw std::invalid_argument("Corrupt matrix file header: " + path);
+
+    std::uint64_t maxElements = std::numeric_limits<std::size_t>::max() / sizeof(double);
+    if(header.rowCount > maxElements / header.columnCount)
+        throw std::invalid_argument("Matrix file too large for this machine: " + path);
+    std::uint64_t payloadBytes = header.rowCount * header.columnCount * sizeof(double);
+    if(fileSize < header.payloadOffset || fileSize - header.payloadOffset < payloadBytes)
+        throw std::invalid_argument("Truncated matrix file: " + path);
+    return header;
+}
+
+FileHeader makeHeader(const MatrixSize& matrixSize) {
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = MATRIX_FILE_VERSION;
+    header.elementType = ELEMENT_DOUBLE;
+    header.endianMark = ENDIAN_MARK;
+    header.alignment = PAYLOAD_ALIGNMENT;
+    header.rowCount = matrixSize.rowCount;
+    header.columnCount = matrixSize.columnCount;
+    header.payloadOffset = sizeof(FileHeader);
+    return header;
+}
+
+}
+
+void saveMatrix(const std::string& path, ConstMatrixView matrix) {
+    if(!matrix.isRowMajor()) {    // The payload is row-major, write it from contiguous rows
+        saveMatrix(path, Matrix(matrix));
+        return;
+    }
+    const MatrixSize& matrixSize = matrix.getDimension();
+    FileHeader header = makeHeader(matrixSize);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file)
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    auto rowBytes = static_cast<std::streamsize>(matrixSize.columnCount * sizeof(double));
+    if(matrix.getStride() == matrixSize.columnCount)    // Contiguous: one write for the whole payload
+        file.write(reinterpret_cast<const char*>(matrix.data()), rowBytes * static_cast<std::streamsize>(matrixSize.rowCount));
+    else
+        for(std::size_t i = 0; i < matrixSize.rowCount; i++)
+            file.write(reinterpret_cast<const char*>(matrix.data() + i * matrix.getStride()), rowBytes);
+    file.flush();
+    if(!file)
+        throw std::runtime_error("Cannot write file: " + path);
+}
+
+Matrix loadMatrix(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if(!file)
+        throw std::runtime_error("Cannot open file: " + path);
+    auto fileSize = static_cast<std::uint64_t>(file.tellg());
+    FileHeader header{};
+    file.seekg(0);
+    if(fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        throw std::invalid_argument("Not a matrix file: " + path);
+    bool swapped = false;
+    header = parseHeader(header, fileSize, path, swapped);
+
+    Matrix result(static_cast<std::size_t>(header.rowCount), static_cast<std::size_t>(header.columnCount));
+    MatrixView elements = result.view();
+    std::size_t count = static_cast<std::size_t>(header.rowCount * header.columnCount);
+    file.seekg(static_cast<std::streamoff>(header.payloadOffset));
+    if(!file.read(reinterpret_cast<char*>(elements.data()), static_cast<std::streamsize>(count * sizeof(double))))
+        throw std::runtime_error("Cannot read file: " + path);
+    if(swapped)
+        for(std::size_t k = 0; k < count; k++)
+            elements.data()[k] = byteSwapped(elements.data()[k]);
+    return result;
+}
+
+// Constructors
+
+MappedMatrix::MappedMatrix(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error("Cannot open file: " + path);
+    LARGE_INTEGER fileSize{};
+    GetFileSizeEx(file, &fileSize);
+    mappingSize = static_cast<std::size_t>(fileSize.QuadPart);
+    HANDLE mapObject = mappingSize ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    CloseHandle(file);
+    if(mapObject)
+        mapping = MapViewOfFile(mapObject, FILE_MAP_READ, 0, 0, 0);
+    if(mapObject)
+        CloseHandle(mapObject);
+    if(!mapping && mappingSize)
+        throw std::runtime_error("Cannot map file: " + path);
+#else
+    int file = ::open(path.c_str(), O_RDONLY);
+    if(file < 0)
+        throw std::runtime_error("Cannot open file: " + path);
+    struct stat status{};
+    if(::fstat(file, &status) != 0) {
+        ::close(file);
+        throw std::runtime_error("Cannot open file: " + path);
+    }
+    mappingSize = static_cast<std::size_t>(status.st_size);
+    if(mappingSize)
+        mapping = ::mmap(nullptr, mappingSize, PROT_READ, MAP_SHARED, file, 0);
+    ::close(file);    // The mapping keeps the file referenced
+    if(mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error("Cannot map file: " + path);
+    }
+#endif
+
+    try {
+        FileHeader header{};
+        if(mappingSize < sizeof(header))
+            throw std::invalid_argument("Not a matrix file: " + path);
+        std::memcpy(&header, mapping, sizeof(header));
+        bool swapped = false;
+        header = parseHeader(header, mappingSize, path, swapped);
+        if(swapped)
+            throw std::invalid_argument("Matrix file has the other byte order, use loadMatrix(): " + path);
+        size.rowCount = static_cast<std::size_t>(header.rowCount);
+        size.columnCount = static_cast<std::size_t>(header.columnCount);
+        elements = reinterpret_cast<const double*>(static_cast<const char*>(mapping) + header.payloadOffset);
+    } catch(...) {
+        unmap();
+        throw;
+    }
+}
+
+// (Move & Copy) (Constructor & Assignment)
+
+MappedMatrix::MappedMatrix(MappedMatrix&& matrix) noexcept
+    : mapping(std::exchange(matrix.mapping, nullptr)), mappingSize(std::exchange(matrix.mappingSize, 0)),
+      size(std::exchange(matrix.size, MatrixSize())), elements(std::exchange(matrix.elements, nullptr)) {}
+
+MappedMatrix& MappedMatrix::operator=(MappedMatrix&& matrix) noexcept {
+    if(this != &matrix) {
+        unmap();
+        mapping = std::exchange(matrix.mapping, nullptr);
+        mappingSize = std::exchange(matrix.mappingSize, 0);
+        size = std::exchange(matrix.size, MatrixSize());
+        elements = std::exchange(matrix.elements, nullptr);
+    }
+    return *this;
+}
+
+// Methods
+
+void MappedMatrix::unmap() noexcept {
+    if(!mapping)
+        return;
+#ifdef _WIN32
+    UnmapViewOfFile(mapping);
+#else
+    ::munmap(mapping, mappingSize);
+#endif
+    mapping = nullptr;
+}
+
+Matrix MappedMatrix::toMatrix() const {
+    return Matrix(view());
+}
+
+// Getters
+
+const MatrixSize& MappedMatrix::getDimension() const {
+    return size;
+}
+
+ConstMatrixView MappedMatrix::view() const {
+    return ConstMatrixView(elements, size.rowCount, size.columnCount, size.columnCount);
+}
+
+// Class Operators
+
+MappedMatrix::operator ConstMatrixView() const {
+    return view();
+}
+
+// Destructor
+
+MappedMatrix::~MappedMatrix() {
+    unmap();
+}
+
+// DiskMatrix
+
+// Constructors
+DiskMatrix::DiskMatrix(const std::string& filePath) : path(filePath) {
+    file.open(path, std::ios::binary | std::ios::in | std::ios::out);
+    if(!file) {
+        file.clear();
+        file.open(path, std::ios::binary | std::ios::in);
+        writable = false;
+    }
+    if(!file)
+        throw std::runtime_error("Cannot open file: " + path);
+
+    file.seekg(0, std::ios::end);
+    auto fileSize = static_cast<std::uint64_t>(file.tellg());
+    FileHeader header{};
+    file.seekg(0);
+    if(fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+        throw std::invalid_argument("Not a matrix file: " + path);
+    bool swapped = false;
+    header = parseHeader(header, fileSize, path, swapped);
+    if(swapped)
+        throw std::invalid_argument("Matrix file has the other byte order, use loadMatrix(): " + path);
+    size.rowCount = static_cast<std::size_t>(header.rowCount);
+    size.columnCount = static_cast<std::size_t>(header.columnCount);
+    payloadOffset = header.payloadOffset;
+}
+
+DiskMatrix::DiskMatrix(const std::string& filePath, std::size_t rowCount, std::size_t columnCount) : path(filePath) {
+    size.rowCount = rowCount;
+    size.columnCount = columnCount;
+    if(!size.validate())
+        throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
+    if(rowCount > std::numeric_limits<std::size_t>::max() / sizeof(double) / columnCount)
+        throw std::invalid_argument("Matrix too large for this machine");
+    FileHeader header = makeHeader(size);
+    payloadOffset = header.payloadOffset;
+
+    file.open(path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    if(!file)
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    // Writing the last byte sizes the file; the untouched payload reads back as zeros (and stays sparse where supported).
+    file.seekp(static_cast<std::streamoff>(payloadOffset + rowCount * columnCount * sizeof(double) - 1));
+    file.put('\0');
+    file.flush();
+    if(!file)
+        throw std::runtime_error("Cannot write file: " + path);
+}
+
+void DiskMatrix::checkBlock(std::size_t rowStart, std::size_t columnStart, const MatrixSize& blockSize) const {
+    if(rowStart + blockSize.rowCount > size.rowCount || columnStart + blockSize.columnCount > size.columnCount)
+        throw std::invalid_argument("Index out of bound");
+}
+
+std::streamoff DiskMatrix::offset(std::size_t i, std::size_t j) const {
+    return static_cast<std::streamoff>(payloadOffset + (i * size.columnCount + j) * sizeof(double));
+}
+
+// Methods
+void DiskMatrix::readBlock(std::size_t rowStart, std::size_t columnStart, MatrixView block) const {
+    const MatrixSize& blockSize = block.getDimension();
+    checkBlock(rowStart, columnStart, blockSize);
+    if(!block.isRowMajor()) {     // Rows are read straight into the block, so a transposed one is filled from a copy
+        Matrix rows(blockSize);
+        readBlock(rowStart, columnStart, rows);
+        block = rows.view();
+        return;
+    }
+    auto rowBytes = static_cast<std::streamsize>(blockSize.columnCount * sizeof(double));
+    bool whole = columnStart == 0 && blockSize.columnCount == size.columnCount && block.getStride() == size.columnCount;
+    file.seekg(offset(rowStart, columnStart));
+    if(whole)     // Whole rows into a contiguous block: a single read
+        file.read(reinterpret_cast<char*>(block.data()), rowBytes * static_cast<std::streamsize>(blockSize.rowCount));
+    for(std::size_t i = 0; !whole && i < blockSize.rowCount && file; i++) {
+        file.seekg(offset(rowStart + i, columnStart));
+        file.read(reinterpret_cast<char*>(block.data() + i * block.getStride()), rowBytes);
+    }
+    if(!file)
+        throw std::runtime_error("Cannot read file: " + path);
+}
+
+void DiskMatrix::writeBlock(std::size_t rowStart, std::size_t columnStart, ConstMatrixView block) {
+    if(!writable)
+        throw std::runtime_error("File is read-only: " + path);
+    const MatrixSize& blockSize = block.getDimension();
+    checkBlock(rowStart, columnStart, blockSize);
+    if(!block.isRowMajor()) {
+        writeBlock(rowStart, columnStart, Matrix(block));
+        return;
+    }
+    auto rowBytes = static_cast<std::streamsize>(blockSize.columnCount * sizeof(double));
+    for(std::size_t i = 0; i < blockSize.rowCount && file; i++) {
+        file.seekp(offset(rowStart + i, columnStart));
+        file.write(reinterpret_cast<const char*>(block.data() + i * block.getStride()), rowBytes);
+    }
+    file.flush();
+    if(!file)
+        throw std::runtime_error("Cannot write file: " + path);
+}
+
+Matrix DiskMatrix::toMatrix() const {
+    Matrix result(size);
+    readBlock(0, 0, result);
+    return result;
+}
+
+// Getters
+const MatrixSize& DiskMatrix::getDimension() const {
+    return size;
+}
+
+const std::string& DiskMatrix::getPath() const {
+    return path;
+}
@@ -0,0 +1,61 @@
+#include "MatrixPowerCache.hpp"
+
+#include <utility>
+
+// Constructors
+
+MatrixPowerCache::MatrixPowerCache(const SquareMatrix& matrix) : scratch(matrix.getDimension().rowCount) {
+    ladder.reserve(8 * sizeof(std::size_t));
+    ladder.push_back(matrix);
+}
+
+// Methods
+
+void MatrixPowerCache::extendTo(std::size_t level) {
+    while(ladder.size() <= level) {
+        gemm(1.0, ladder.back(), ladder.back(), 0.0, scratch);
+        ladder.push_back(scratch);
+    }
+}
+
+SquareMatrix MatrixPowerCache::power(std::size_t exponent) {
+    SquareMatrix result(getMatrix().getDimension().rowCount);
+    power(exponent, result);
+    return result;
+}
+
+void MatrixPowerCache::power(std::size_t exponent, SquareMatrix& result) {
+    std::size_t n = getMatrix().getDimension().rowCount;
+    if(exponent == 0) {
+        result = SquareMatrix::identity(n);
+        return;
+    }
+
+    std::size_t highest = 0;
+    while(exponent >> (highest + 1))
+        highest++;
+    extendTo(highest);
+
+    bool first(true);
+    for(std::size_t level = 0; level <= highest; level++) {
+        if(!((exponent >> level) & 1))
+            continue;
+        if(first) {
+            result = ladder[level];
+            first = false;
+        } else {
+            gemm(1.0, result, ladder[level], 0.0, scratch);
+            std::swap(result, scratch);
+        }
+    }
+}
+
+// Getters
+
+const SquareMatrix& MatrixPowerCache::getMatrix() const {
+    return ladder.front();
+}
+
+std::size_t MatrixPowerCache::getCachedLevels() const {
+    return ladder.size();
+}
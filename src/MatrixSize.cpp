@@ -0,0 +1,7 @@
+#include "MatrixSize.hpp"
+
+bool MatrixSize::validate() const {
+    if( rowCount > 0 && columnCount > 0 )
+        return true;
+    return false;
+}
@@ -0,0 +1,525 @@
+#include "MatrixText.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "ThreadPool.hpp"
+
+namespace {
+
+constexpr std::size_t CHUNK = 32 << 20;     // Bytes read from the file per step
+constexpr std::size_t PIECE = 1 << 20;      // Bytes of text per parse / format task
+constexpr std::size_t TASKS_PER_THREAD = 4;
+
+// Reads a text file in chunks of about CHUNK bytes, each ending at a line boundary (or at the end of the file).
+class ChunkReader {
+private:
+    std::ifstream file;
+    std::string path;
+    std::string pending{};   // Start of a line cut off at the end of the previous chunk
+
+public:
+    explicit ChunkReader(const std::string& filePath) : file(filePath, std::ios::binary), path(filePath) {
+        if(!file)
+            throw std::runtime_error("Cannot open file: " + path);
+    }
+
+    // False once the whole file has been returned
+    bool next(std::string& chunk) {
+        chunk = std::move(pending);
+        pending.clear();
+        while(file) {
+            std::size_t start = chunk.size();
+            chunk.resize(start + CHUNK);
+            file.read(&chunk[start], static_cast<std::streamsize>(CHUNK));
+            chunk.resize(start + static_cast<std::size_t>(file.gcount()));
+            if(file.bad())
+                throw std::runtime_error("Cannot read file: " + path);
+            if(file.eof())
+                break;
+            std::size_t cut = chunk.rfind('\n');
+            if(cut != std::string::npos) {
+                pending.assign(chunk, cut + 1, std::string::npos);
+                chunk.resize(cut + 1);
+                return true;
+            }
+        }
+        return !chunk.empty();
+    }
+};
+
+std::size_t pieceBudget() {
+    return ThreadPool::instance().getThreadCount() * TASKS_PER_THREAD;
+}
+
+// Runs task(0) ... task(count - 1), on the thread pool when there is more than one.
+template<typename Task>
+void runPieces(std::size_t count, const Task& task) {
+    if(count == 1)
+        task(0);
+    else
+        ThreadPool::instance().parallelFor(count, task);
+}
+
+// Cuts text into pieces of at least PIECE bytes (at most pieceBudget() of them) ending at line boundaries,
+// parses each into its own Result with parse(piece, result) and returns the results in text order.
+template<typename Result, typename Parse>
+std::vector<Result> parsePieces(std::string_view text, const Parse& parse) {
+    std::size_t count = std::max<std::size_t>(1, std::min(pieceBudget(), text.size() / PIECE));
+    std::vector<std::string_view> pieces;
+    std::size_t start = 0;
+    for(std::size_t k = 1; k <= count; k++) {
+        std::size_t end = text.size();
+        if(k < count) {
+            end = text.find('\n', std::max(start, text.size() / count * k));
+            end = end == std::string_view::npos ? text.size() : end + 1;
+        }
+        pieces.push_back(text.substr(start, end - start));
+        start = end;
+    }
+
+    std::vector<Result> results(pieces.size());
+    runPieces(pieces.size(), [&](std::size_t idx) { parse(pieces[idx], results[idx]); });
+    return results;
+}
+
+// Calls body(line) for every line of text, without its line break ("\n" or "\r\n").
+template<typename Body>
+void forEachLine(std::string_view text, const Body& body) {
+    while(!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        if(!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        body(line);
+    }
+}
+
+bool isBlank(char c, char delimiter) {
+    return c != delimiter && (c == ' ' || c == '\t' || c == '\r');
+}
+
+const char* skipBlanks(const char* p, const char* end, char delimiter = '\n') {
+    while(p != end && isBlank(*p, delimiter))
+        p++;
+    return p;
+}
+
+// Parses the number starting at p (after blanks) and moves p past it.
+double parseNumber(const char*& p, const char* end, char delimiter = '\n') {
+    p = skipBlanks(p, end, delimiter);
+    if(p != end && *p == '+')     // from_chars takes no leading plus
+        p++;
+    double value{};
+    auto [next, error] = std::from_chars(p, end, value);
+    if(error != std::errc())
+        throw std::invalid_argument("Not a number: \"" + std::string(p, std::min<std::size_t>(16, static_cast<std::size_t>(end - p))) + "\"");
+    p = next;
+    return value;
+}
+
+void appendNumber(std::string& out, double value) {
+    char buffer[32];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);   // Shortest round-trip form
+}
+
+void appendNumber(std::string& out, std::size_t value) {
+    char buffer[24];
+    out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+}
+
+std::ofstream openForWriting(const std::string& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if(!file)
+        throw std::runtime_error("Cannot open file for writing: " + path);
+    return file;
+}
+
+void finishWriting(std::ofstream& file, const std::string& path) {
+    file.flush();
+    if(!file)
+        throw std::runtime_error("Cannot write file: " + path);
+}
+
+// Formats items [0, count) with format(item, text) and writes the text in item order. Items are grouped
+// into pieces of about PIECE bytes (given the estimated bytesPerItem) and a batch of pieces is formatted
+// in parallel before being written.
+template<typename Format>
+void writeItems(std::ofstream& file, std::size_t count, std::size_t bytesPerItem, const Format& format) {
+    std::size_t itemsPerPiece = std::max<std::size_t>(1, PIECE / std::max<std::size_t>(1, bytesPerItem));
+    std::size_t pieceCount = (count + itemsPerPiece - 1) / itemsPerPiece;
+    std::vector<std::string> texts(std::max<std::size_t>(1, std::min(pieceBudget(), pieceCount)));
+    for(std::size_t first = 0; first < pieceCount; first += texts.size()) {
+        std::size_t pieces = std::min(texts.size(), pieceCount - first);
+        runPieces(pieces, [&](std::size_t idx) {
+            std::string& text = texts[idx];
+            text.clear();
+            std::size_t begin = (first + idx) * itemsPerPiece;
+            for(std::size_t item = begin; item < std::min(count, begin + itemsPerPiece); item++)
+                format(item, text);
+        });
+        for(std::size_t idx = 0; idx < pieces; idx++)
+            file.write(texts[idx].data(), static_cast<std::streamsize>(texts[idx].size()));
+    }
+}
+
+// CSV
+
+struct CsvPiece {
+    std::vector<double> values{};
+    std::size_t rowCount{};
+    std::size_t columnCount{};
+};
+
+void parseCsv(std::string_view text, char delimiter, CsvPiece& piece) {
+    forEachLine(text, [&](std::string_view line) {
+        const char* p = line.data();
+        const char* end = p + line.size();
+        if(skipBlanks(p, end, delimiter) == end)
+            return;
+        std::size_t fields = 0;
+        while(true) {
+            piece.values.push_back(parseNumber(p, end, delimiter));
+            fields++;
+            p = skipBlanks(p, end, delimiter);
+            if(p == end)
+                break;
+            if(*p != delimiter)
+                throw std::invalid_argument("Unexpected character '" + std::string(1, *p) + "' in CSV row");
+            p++;
+        }
+        if(piece.rowCount == 0)
+            piece.columnCount = fields;
+        else if(fields != piece.columnCount)
+            throw std::invalid_argument("Every row should contain same amount of elements!");
+        piece.rowCount++;
+    });
+}
+
+// Matrix Market
+
+enum class Symmetry {
+    General,
+    Symmetric,
+    SkewSymmetric
+};
+
+struct MarketHeader {
+    bool coordinate{};
+    bool pattern{};
+    Symmetry symmetry{Symmetry::General};
+    std::size_t rowCount{};
+    std::size_t columnCount{};
+    std::size_t entryCount{};    // Entries listed in the file
+};
+
+void parseBanner(std::string_view line, MarketHeader& header) {
+    std::vector<std::string> words;
+    std::string word;
+    for(char c: line) {
+        if(c == ' ' || c == '\t') {
+            if(!word.empty())
+                words.push_back(std::move(word));
+            word.clear();
+        } else {
+            word.push_back(static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+        }
+    }
+    if(!word.empty())
+        words.push_back(std::move(word));
+
+    if(words.size() != 5 || words[0] != "%%matrixmarket" || words[1] != "matrix")
+        throw std::invalid_argument("Not a Matrix Market matrix file");
+    if(words[2] != "coordinate" && words[2] != "array")
+        throw std::invalid_argument("Unknown Matrix Market format: " + words[2]);
+    header.coordinate = words[2] == "coordinate";
+    if(words[3] == "complex")
+        throw std::invalid_argument("Complex Matrix Market files are not supported");
+    if(words[3] != "real" && words[3] != "double" && words[3] != "integer" && words[3] != "pattern")
+        throw std::invalid_argument("Unknown Matrix Market field: " + words[3]);
+    header.pattern = words[3] == "pattern";
+    if(header.pattern && !header.coordinate)
+        throw std::invalid_argument("Pattern Matrix Market files should be in coordinate format");
+    if(words[4] == "symmetric" || words[4] == "hermitian")     // Real Hermitian is symmetric
+        header.symmetry = Symmetry::Symmetric;
+    else if(words[4] == "skew-symmetric")
+        header.symmetry = Symmetry::SkewSymmetric;
+    else if(words[4] != "general")
+        throw std::invalid_argument("Unknown Matrix Market symmetry: " + words[4]);
+}
+
+void parseSizeLine(std::string_view line, MarketHeader& header) {
+    const char* p = line.data();
+    const char* end = p + line.size();
+    auto count = [&]() {
+        double value = parseNumber(p, end);
+        if(value < 0 || value != static_cast<double>(static_cast<std::size_t>(value)))
+            throw std::invalid_argument("Invalid Matrix Market size line");
+        return static_cast<std::size_t>(value);
+    };
+    header.rowCount = count();
+    header.columnCount = count();
+    if(header.rowCount == 0 || header.columnCount == 0)
+        throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
+    if(header.symmetry != Symmetry::General && header.rowCount != header.columnCount)
+        throw std::invalid_argument("This is not Square Matrix!");
+
+    if(header.coordinate) {
+        header.entryCount = count();
+    } else {
+        std::size_t n = header.rowCount;
+        if(header.symmetry == Symmetry::General)
+            header.entryCount = header.rowCount * header.columnCount;
+        else
+            header.entryCount = header.symmetry == Symmetry::Symmetric ? n * (n + 1) / 2 : n * (n - 1) / 2;
+    }
+    if(skipBlanks(p, end) != end)
+        throw std::invalid_argument("Invalid Matrix Market size line");
+}
+
+// Every number of the data lines, in file order (comment and blank lines skipped)
+void parseNumbers(std::string_view text, std::vector<double>& numbers) {
+    forEachLine(text, [&](std::string_view line) {
+        const char* p = line.data();
+        const char* end = p + line.size();
+        p = skipBlanks(p, end);
+        if(p == end || *p == '%')
+            return;
+        while(p != end) {
+            numbers.push_back(parseNumber(p, end));
+            p = skipBlanks(p, end);
+        }
+    });
+}
+
+// Turns the stream of numbers that follows the size line into entries, put(i, j, value), including the
+// mirrored entries of symmetric layouts.
+template<typename Put>
+class MarketEntries {
+private:
+    const MarketHeader& header;
+    const Put& put;
+    std::size_t entries{};
+    std::size_t row{};
+    std::size_t column{};
+    double group[3]{};
+    std::size_t grouped{};
+
+    std::size_t index(double value, std::size_t count) const {
+        if(!(value >= 1 && value <= static_cast<double>(count)) || value != static_cast<double>(static_cast<std::size_t>(value)))
+            throw std::invalid_argument("Index out of bound");
+        return static_cast<std::size_t>(value) - 1;
+    }
+
+    void entry(std::size_t i, std::size_t j, double value) {
+        if(header.symmetry != Symmetry::General && i < j)
+            throw std::invalid_argument("Symmetric Matrix Market files list the lower triangle only");
+        if(header.symmetry == Symmetry::SkewSymmetric && i == j)
+            throw std::invalid_argument("Skew-symmetric Matrix Market files have no diagonal entries");
+        put(i, j, value);
+        if(header.symmetry != Symmetry::General && i != j)
+            put(j, i, header.symmetry == Symmetry::Symmetric ? value : -value);
+        entries++;
+    }
+
+public:
+    MarketEntries(const MarketHeader& marketHeader, const Put& putEntry) : header(marketHeader), put(putEntry) {
+        row = header.symmetry == Symmetry::SkewSymmetric ? 1 : 0;
+    }
+
+    void consume(double number) {
+        if(entries == header.entryCount)
+            throw std::invalid_argument("Matrix Market file has more than " + std::to_string(header.entryCount) + " entries");
+        if(!header.coordinate) {    // Column by column, lower triangle only when symmetric
+            std::size_t i = row, j = column;
+            if(++row == header.rowCount) {
+                column++;
+                row = header.symmetry == Symmetry::General ? 0 : column + (header.symmetry == Symmetry::SkewSymmetric);
+            }
+            entry(i, j, number);
+            return;
+        }
+        group[grouped++] = number;
+        if(grouped == (header.pattern ? 2 : 3)) {
+            grouped = 0;
+            entry(index(group[0], header.rowCount), index(group[1], header.columnCount), header.pattern ? 1.0 : group[2]);
+        }
+    }
+
+    void finish() const {
+        if(entries != header.entryCount || grouped != 0)
+            throw std::invalid_argument("Matrix Market file should contain " + std::to_string(header.entryCount) + " entries");
+    }
+};
+
+// Reads the banner and size line, calls start(header), then feeds every entry to put(i, j, value).
+template<typename Start, typename Put>
+void readMatrixMarket(const std::string& path, const Start& start, const Put& put) {
+    ChunkReader reader(path);
+    std::string chunk;
+    MarketHeader header;
+    bool banner = false, sized = false;
+    std::string_view body;
+    while(!sized && reader.next(chunk)) {
+        body = chunk;
+        while(!sized && !body.empty()) {
+            std::size_t end = body.find('\n');
+            std::string_view line = body.substr(0, end);
+            body = end == std::string_view::npos ? std::string_view() : body.substr(end + 1);
+            if(!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+            if(!banner) {
+                parseBanner(line, header);
+                banner = true;
+            } else if(skipBlanks(line.data(), line.data() + line.size()) != line.data() + line.size() && line[0] != '%') {
+                parseSizeLine(line, header);
+                sized = true;
+            }
+        }
+    }
+    if(!sized)
+        throw std::invalid_argument(banner ? "Matrix Market file has no size line" : "Not a Matrix Market matrix file");
+    start(header);
+
+    MarketEntries<Put> entries(header, put);
+    auto consume = [&](std::string_view text) {
+        for(const std::vector<double>& numbers: parsePieces<std::vector<double>>(text, parseNumbers))
+            for(double number: numbers)
+                entries.consume(number);
+    };
+    consume(body);
+    while(reader.next(chunk))
+        consume(chunk);
+    entries.finish();
+}
+
+}
+
+void saveCsv(const std::string& path, ConstMatrixView matrix, char delimiter) {
+    std::ofstream file = openForWriting(path);
+    const MatrixSize& size = matrix.getDimension();
+    writeItems(file, size.rowCount, size.columnCount * 24, [&](std::size_t i, std::string& text) {
+        for(std::size_t j = 0; j < size.columnCount; j++) {
+            if(j)
+                text.push_back(delimiter);
+            appendNumber(text, matrix.element(i, j));
+        }
+        text.push_back('\n');
+    });
+    finishWriting(file, path);
+}
+
+Matrix loadCsv(const std::string& path, char delimiter, bool skipHeader) {
+    ChunkReader reader(path);
+    std::string chunk;
+    AlignedBuffer values;
+    std::size_t rowCount = 0, columnCount = 0;
+    bool first = true;
+    while(reader.next(chunk)) {
+        std::string_view text = chunk;
+        if(first && skipHeader) {
+            std::size_t end = text.find('\n');
+            text = end == std::string_view::npos ? std::string_view() : text.substr(end + 1);
+        }
+        first = false;
+        auto pieces = parsePieces<CsvPiece>(text, [&](std::string_view piece, CsvPiece& result) {
+            parseCsv(piece, delimiter, result);
+        });
+        for(const CsvPiece& piece: pieces) {
+            if(piece.rowCount == 0)
+                continue;
+            if(rowCount == 0)
+                columnCount = piece.columnCount;
+            else if(piece.columnCount != columnCount)
+                throw std::invalid_argument("Every row should contain same amount of elements!");
+            values.insert(values.end(), piece.values.begin(), piece.values.end());
+            rowCount += piece.rowCount;
+        }
+    }
+    if(rowCount == 0)
+        throw std::invalid_argument("CSV file has no rows: " + path);
+    return Matrix(rowCount, columnCount, std::move(values));
+}
+
+void saveMatrixMarket(const std::string& path, ConstMatrixView matrix) {
+    std::ofstream file = openForWriting(path);
+    const MatrixSize& size = matrix.getDimension();
+    std::string header = "%%MatrixMarket matrix array real general\n";
+    appendNumber(header, size.rowCount);
+    header.push_back(' ');
+    appendNumber(header, size.columnCount);
+    header.push_back('\n');
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    writeItems(file, size.columnCount, size.rowCount * 24, [&](std::size_t j, std::string& text) {
+        for(std::size_t i = 0; i < size.rowCount; i++) {
+            appendNumber(text, matrix.element(i, j));
+            text.push_back('\n');
+        }
+    });
+    finishWriting(file, path);
+}
+
+void saveMatrixMarket(const std::string& path, const SparseMatrix& matrix) {
+    std::ofstream file = openForWriting(path);
+    const MatrixSize& size = matrix.getDimension();
+    std::string header = "%%MatrixMarket matrix coordinate real general\n";
+    appendNumber(header, size.rowCount);
+    header.push_back(' ');
+    appendNumber(header, size.columnCount);
+    header.push_back(' ');
+    appendNumber(header, matrix.getNonZeroCount());
+    header.push_back('\n');
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+    const std::vector<std::size_t>& rowStart = matrix.getRowStarts();
+    const std::vector<std::size_t>& columnIndex = matrix.getColumnIndices();
+    const std::vector<double>& values = matrix.getValues();
+    std::size_t bytesPerRow = 40 * (matrix.getNonZeroCount() / size.rowCount + 1);
+    writeItems(file, size.rowCount, bytesPerRow, [&](std::size_t i, std::string& text) {
+        for(std::size_t k = rowStart[i]; k < rowStart[i + 1]; k++) {
+            appendNumber(text, i + 1);
+            text.push_back(' ');
+            appendNumber(text, columnIndex[k] + 1);
+            text.push_back(' ');
+            appendNumber(text, values[k]);
+            text.push_back('\n');
+        }
+    });
+    finishWriting(file, path);
+}
+
+Matrix loadMatrixMarket(const std::string& path) {
+    Matrix result(1, 1);
+    double* elements = nullptr;
+    std::size_t stride = 0;
+    readMatrixMarket(path, [&](const MarketHeader& header) {
+        result = Matrix(header.rowCount, header.columnCount);
+        elements = result.view().data();
+        stride = result.view().getStride();
+    }, [&](std::size_t i, std::size_t j, double value) {
+        elements[i * stride + j] += value;     // Repeated coordinates add up, as in SparseMatrix
+    });
+    return result;
+}
+
+SparseMatrix loadSparseMatrixMarket(const std::string& path) {
+    MarketHeader size;
+    std::vector<Triplet> triplets;
+    readMatrixMarket(path, [&](const MarketHeader& header) {
+        size = header;
+        triplets.reserve(header.symmetry == Symmetry::General ? header.entryCount : 2 * header.entryCount);
+    }, [&](std::size_t i, std::size_t j, double value) {
+        if(value != 0.0)
+            triplets.push_back({i, j, value});
+    });
+    return SparseMatrix(size.rowCount, size.columnCount, triplets);
+}
@@ -0,0 +1,176 @@
+#include "MemoryResource.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t ALIGNMENT = 64;
+
+// Allocation counters of one thread, on a cache line of their own. Only the owning thread writes them
+// (a relaxed load and store, no read-modify-write), so counting allocations shares nothing between threads.
+struct alignas(64) ThreadCounters {
+    std::atomic<std::size_t> allocations{};
+    std::atomic<std::size_t> deallocations{};
+    std::atomic<std::size_t> bytesAllocated{};
+    std::atomic<std::size_t> heapAllocations{};
+    std::atomic<std::size_t> heapBytes{};
+};
+
+// Every thread's counters, summed by allocationStats(). Blocks are never freed, since thread_local buffers
+// (the GEMM workspaces, ...) are still released after their thread's other thread_locals are gone.
+struct CounterRegistry {
+    std::mutex mutex{};
+    std::vector<std::unique_ptr<ThreadCounters>> threads{};
+    ThreadCounters fallback{};      // Shared by threads whose own block could not be allocated
+    AllocationStats baseline{};     // Totals at the last resetAllocationStats()
+};
+
+CounterRegistry& counterRegistry() {
+    static auto* registry = new CounterRegistry();
+    return *registry;
+}
+
+ThreadCounters* registerThread() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    try {
+        registry.threads.push_back(std::make_unique<ThreadCounters>());
+        return registry.threads.back().get();
+    } catch(const std::bad_alloc&) {
+        return &registry.fallback;     // recordAllocation() is noexcept: count approximately instead
+    }
+}
+
+ThreadCounters& threadCounters() {
+    thread_local ThreadCounters* counters = registerThread();
+    return *counters;
+}
+
+void bump(std::atomic<std::size_t>& counter, std::size_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void addCounters(AllocationStats& total, const ThreadCounters& counters) {
+    total.allocations += counters.allocations.load(std::memory_order_relaxed);
+    total.deallocations += counters.deallocations.load(std::memory_order_relaxed);
+    total.bytesAllocated += counters.bytesAllocated.load(std::memory_order_relaxed);
+    total.heapAllocations += counters.heapAllocations.load(std::memory_order_relaxed);
+    total.heapBytes += counters.heapBytes.load(std::memory_order_relaxed);
+}
+
+// Sum over every thread since the process started; the registry mutex must be held.
+AllocationStats totalStats(const CounterRegistry& registry) {
+    AllocationStats total;
+    addCounters(total, registry.fallback);
+    for(const auto& counters: registry.threads)
+        addCounters(total, *counters);
+    return total;
+}
+
+class AlignedHeapResource : public std::pmr::memory_resource {
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        void* pointer = ::operator new(bytes, std::align_val_t{std::max(alignment, ALIGNMENT)});
+        ThreadCounters& counters = threadCounters();
+        bump(counters.heapAllocations, 1);
+        bump(counters.heapBytes, bytes);
+        return pointer;
+    }
+
+    void do_deallocate(void* pointer, std::size_t, std::size_t alignment) override {
+        ::operator delete(pointer, std::align_val_t{std::max(alignment, ALIGNMENT)});
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+std::atomic<std::pmr::memory_resource*> defaultResource{nullptr};
+thread_local std::pmr::memory_resource* scopedResource = nullptr;
+thread_local std::size_t threadAllocatedBytes = 0;
+
+}
+
+std::pmr::memory_resource* alignedHeapResource() {
+    static AlignedHeapResource resource;
+    return &resource;
+}
+
+std::pmr::memory_resource* pooledResource() {
+    // Never destroyed: buffers of static objects may still be returned to it during exit.
+    static auto* resource = new std::pmr::synchronized_pool_resource(alignedHeapResource());
+    return resource;
+}
+
+void setDefaultMemoryResource(std::pmr::memory_resource* resource) {
+    defaultResource.store(resource, std::memory_order_release);
+}
+
+std::pmr::memory_resource* defaultMemoryResource() {
+    std::pmr::memory_resource* resource = defaultResource.load(std::memory_order_acquire);
+    return resource ? resource : alignedHeapResource();
+}
+
+std::pmr::memory_resource* currentMemoryResource() {
+    return scopedResource ? scopedResource : defaultMemoryResource();
+}
+
+// ScopedMemoryResource
+
+ScopedMemoryResource::ScopedMemoryResource(std::pmr::memory_resource* resource) : previous(scopedResource) {
+    scopedResource = resource;
+}
+
+ScopedMemoryResource::~ScopedMemoryResource() {
+    scopedResource = previous;
+}
+
+// ScopedArena
+
+ScopedArena::ScopedArena(std::size_t initialSize) : arena(initialSize, alignedHeapResource()), scope(&arena) {}
+
+std::pmr::memory_resource* ScopedArena::getResource() {
+    return &arena;
+}
+
+// Allocation Statistics
+
+AllocationStats allocationStats() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    AllocationStats stats = totalStats(registry);
+    stats.allocations -= registry.baseline.allocations;
+    stats.deallocations -= registry.baseline.deallocations;
+    stats.bytesAllocated -= registry.baseline.bytesAllocated;
+    stats.heapAllocations -= registry.baseline.heapAllocations;
+    stats.heapBytes -= registry.baseline.heapBytes;
+    return stats;
+}
+
+// Counters only ever grow (each is written by its own thread), so a reset moves the baseline instead.
+void resetAllocationStats() {
+    CounterRegistry& registry = counterRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.baseline = totalStats(registry);
+}
+
+std::size_t threadBytesAllocated() noexcept {
+    return threadAllocatedBytes;
+}
+
+void recordAllocation(std::size_t bytes) noexcept {
+    ThreadCounters& counters = threadCounters();
+    bump(counters.allocations, 1);
+    bump(counters.bytesAllocated, bytes);
+    threadAllocatedBytes += bytes;
+}
+
+void recordDeallocation() noexcept {
+    bump(threadCounters().deallocations, 1);
+}
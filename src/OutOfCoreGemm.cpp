@@ -0,0 +1,95 @@
+#include "OutOfCoreGemm.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+// Depth blocking of the multiply kernel (Gemm.cpp). Tiles that are whole multiples of it split the sum
+// over the shared dimension at the same points as an in-memory product, so every element is accumulated
+// in exactly the same order.
+constexpr std::size_t TILE_GRANULE = 256;
+
+// Two tiles each of A, B and C are in memory at any time
+constexpr std::size_t TILES_IN_FLIGHT = 6;
+
+std::size_t ceilDiv(std::size_t value, std::size_t divisor) {
+    return (value + divisor - 1) / divisor;
+}
+
+}
+
+void outOfCoreMultiply(const DiskMatrix& a, const DiskMatrix& b, DiskMatrix& c, std::size_t memoryBudget) {
+    const MatrixSize& aSize = a.getDimension();
+    const MatrixSize& bSize = b.getDimension();
+    if(aSize.columnCount != bSize.rowCount)
+        throw std::invalid_argument("Left matrix's column count should be equal to right matrix's row count!");
+    if(c.getDimension().rowCount != aSize.rowCount || c.getDimension().columnCount != bSize.columnCount)
+        throw std::invalid_argument("Result matrix should be " + std::to_string(aSize.rowCount) + "x" +
+                                    std::to_string(bSize.columnCount));
+    if(&c == &a || &c == &b || c.getPath() == a.getPath() || c.getPath() == b.getPath())
+        throw std::invalid_argument("Result should be a different file from both operands");
+
+    auto side = static_cast<std::size_t>(std::sqrt(static_cast<double>(memoryBudget / (TILES_IN_FLIGHT * sizeof(double)))));
+    std::size_t T = std::max(TILE_GRANULE, side / TILE_GRANULE * TILE_GRANULE);
+    std::size_t m = aSize.rowCount, n = bSize.columnCount, k = aSize.columnCount;
+    std::size_t rowTiles = ceilDiv(m, T), columnTiles = ceilDiv(n, T), depthTiles = ceilDiv(k, T);
+    std::size_t stepCount = rowTiles * columnTiles * depthTiles;
+    auto extent = [&](std::size_t idx, std::size_t count) { return std::min(T, count - idx * T); };
+
+    Matrix aTiles[2] = {Matrix(std::min(T, m), std::min(T, k)), Matrix(std::min(T, m), std::min(T, k))};
+    Matrix bTiles[2] = {Matrix(std::min(T, k), std::min(T, n)), Matrix(std::min(T, k), std::min(T, n))};
+    Matrix cTiles[2] = {Matrix(std::min(T, m), std::min(T, n)), Matrix(std::min(T, m), std::min(T, n))};
+
+    // Step s multiplies A tile (i, p) by B tile (p, j) into C tile (i, j); p runs fastest.
+    struct Step {
+        std::size_t i, j, p;
+        std::size_t rows, columns, depth;
+    };
+    auto step = [&](std::size_t s) {
+        Step result{};
+        result.p = s % depthTiles;
+        result.j = s / depthTiles % columnTiles;
+        result.i = s / depthTiles / columnTiles;
+        result.rows = extent(result.i, m);
+        result.columns = extent(result.j, n);
+        result.depth = extent(result.p, k);
+        return result;
+    };
+    auto load = [&](std::size_t s) {
+        Step next = step(s);
+        a.readBlock(next.i * T, next.p * T, aTiles[s % 2].subMatrix(0, next.rows - 1, 0, next.depth - 1));
+        b.readBlock(next.p * T, next.j * T, bTiles[s % 2].subMatrix(0, next.depth - 1, 0, next.columns - 1));
+    };
+
+    // Declared after the tiles: on an exception, the futures wait for their threads before the tiles go away.
+    std::future<void> loading = std::async(std::launch::async, load, 0);
+    std::future<void> writing;
+    std::size_t cSlot = 0;
+    for(std::size_t s = 0; s < stepCount; s++) {
+        loading.get();
+        if(s + 1 < stepCount)
+            loading = std::async(std::launch::async, load, s + 1);
+
+        Step current = step(s);
+        MatrixView cTile = cTiles[cSlot].subMatrix(0, current.rows - 1, 0, current.columns - 1);
+        gemm(1.0, aTiles[s % 2].subMatrix(0, current.rows - 1, 0, current.depth - 1),
+             bTiles[s % 2].subMatrix(0, current.depth - 1, 0, current.columns - 1),
+             current.p == 0 ? 0.0 : 1.0, cTile);
+
+        if(current.p + 1 == depthTiles) {
+            // The previous write used the other C tile; it must finish before that tile is reused.
+            if(writing.valid())
+                writing.get();
+            writing = std::async(std::launch::async, [&c, cTile, current, T] {
+                c.writeBlock(current.i * T, current.j * T, cTile);
+            });
+            cSlot ^= 1;
+        }
+    }
+    if(writing.valid())
+        writing.get();
+}
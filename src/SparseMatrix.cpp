@@ -0,0 +1,323 @@
+#include "SparseMatrix.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "ThreadPool.hpp"
+#include "VectorKernels.hpp"
+
+namespace {
+
+constexpr std::size_t PARALLEL_THRESHOLD = 32 * 1024;     // Nonzeros below which one thread does the product
+constexpr std::size_t TASKS_PER_THREAD = 4;
+
+// Calls body(firstRow, endRow) over consecutive row ranges holding about the same number of nonzeros.
+template<typename Body>
+void forEachRowRange(const std::vector<std::size_t>& rowStart, std::size_t work, const Body& body) {
+    std::size_t rowCount = rowStart.size() - 1;
+    std::size_t nonZeros = rowStart.back();
+    std::size_t threadCount = ThreadPool::instance().getThreadCount();
+    if(work < PARALLEL_THRESHOLD || threadCount == 1 || rowCount == 1) {
+        body(0, rowCount);
+        return;
+    }
+
+    std::size_t taskCount = std::min(rowCount, threadCount * TASKS_PER_THREAD);
+    auto boundary = [&](std::size_t task) {
+        if(task == taskCount)
+            return rowCount;
+        std::size_t target = nonZeros * task / taskCount;
+        return static_cast<std::size_t>(std::lower_bound(rowStart.begin(), rowStart.end() - 1, target) - rowStart.begin());
+    };
+    ThreadPool::instance().parallelFor(taskCount, [&](std::size_t task) {
+        body(boundary(task), boundary(task + 1));
+    });
+}
+
+}
+
+// Constructors
+
+SparseMatrix::SparseMatrix(std::size_t rowCount, std::size_t columnCount) {
+    size.rowCount = rowCount;
+    size.columnCount = columnCount;
+    if(!size.validate())
+        throw std::invalid_argument("Condition didn't match (rowCount, columnCount > 0)");
+    rowStart.assign(rowCount + 1, 0);
+}
+
+SparseMatrix::SparseMatrix(std::size_t rowCount, std::size_t columnCount, const std::vector<Triplet>& triplets)
+    : SparseMatrix(rowCount, columnCount) {
+    // Bucket the triplets by row (counting sort), then sort and merge each row by column.
+    for(const Triplet& triplet: triplets) {
+        if(triplet.row >= rowCount || triplet.column >= columnCount)
+            throw std::invalid_argument("Index out of bound");
+        rowStart[triplet.row + 1]++;
+    }
+    std::partial_sum(rowStart.begin(), rowStart.end(), rowStart.begin());
+
+    std::vector<std::pair<std::size_t, double>> entries(triplets.size());
+    std::vector<std::size_t> next(rowStart.begin(), rowStart.end() - 1);
+    for(const Triplet& triplet: triplets)
+        entries[next[triplet.row]++] = {triplet.column, triplet.value};
+
+    columnIndex.reserve(entries.size());
+    values.reserve(entries.size());
+    std::size_t rowBegin = 0;
+    for(std::size_t i = 0; i < rowCount; i++) {
+        auto first = entries.begin() + static_cast<std::ptrdiff_t>(rowBegin);
+        auto last = entries.begin() + static_cast<std::ptrdiff_t>(rowStart[i + 1]);
+        std::stable_sort(first, last, [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+        rowBegin = rowStart[i + 1];
+        rowStart[i + 1] = rowStart[i];
+        for(auto entry = first; entry != last; ++entry) {
+            if(rowStart[i + 1] > rowStart[i] && columnIndex.back() == entry->first) {
+                values.back() += entry->second;
+                continue;
+            }
+            columnIndex.push_back(entry->first);
+            values.push_back(entry->second);
+            rowStart[i + 1]++;
+        }
+    }
+}
+
+SparseMatrix::SparseMatrix(ConstMatrixView matrix)
+    : SparseMatrix(matrix.getDimension().rowCount, matrix.getDimension().columnCount) {
+    for(std::size_t i = 0; i < size.rowCount; i++) {
+        for(std::size_t j = 0; j < size.columnCount; j++) {
+            if(matrix.element(i, j) != 0.0) {
+                columnIndex.push_back(j);
+                values.push_back(matrix.element(i, j));
+            }
+        }
+        rowStart[i + 1] = columnIndex.size();
+    }
+}
+
+SparseMatrix SparseMatrix::merge(const SparseMatrix& lhs, const SparseMatrix& rhs, double sign) {
+    // Row by row merge of the two sorted column lists
+    SparseMatrix result(lhs.size.rowCount, lhs.size.columnCount);
+    result.columnIndex.reserve(lhs.values.size() + rhs.values.size());
+    result.values.reserve(lhs.values.size() + rhs.values.size());
+    for(std::size_t i = 0; i < lhs.size.rowCount; i++) {
+        std::size_t a = lhs.rowStart[i], aEnd = lhs.rowStart[i + 1];
+        std::size_t b = rhs.rowStart[i], bEnd = rhs.rowStart[i + 1];
+        while(a < aEnd || b < bEnd) {
+            if(b == bEnd || (a < aEnd && lhs.columnIndex[a] < rhs.columnIndex[b])) {
+                result.columnIndex.push_back(lhs.columnIndex[a]);
+                result.values.push_back(lhs.values[a++]);
+            } else if(a == aEnd || rhs.columnIndex[b] < lhs.columnIndex[a]) {
+                result.columnIndex.push_back(rhs.columnIndex[b]);
+                result.values.push_back(sign * rhs.values[b++]);
+            } else {
+                result.columnIndex.push_back(lhs.columnIndex[a]);
+                result.values.push_back(lhs.values[a++] + sign * rhs.values[b++]);
+            }
+        }
+        result.rowStart[i + 1] = result.values.size();
+    }
+    return result;
+}
+
+// Compound Assignment
+
+SparseMatrix& SparseMatrix::operator+=(const SparseMatrix& rhs) {
+    return *this = *this + rhs;
+}
+
+SparseMatrix& SparseMatrix::operator-=(const SparseMatrix& rhs) {
+    return *this = *this - rhs;
+}
+
+SparseMatrix& SparseMatrix::operator*=(double coeff) {
+    activeVectorKernels().scale(values.data(), coeff, values.data(), values.size());
+    return *this;
+}
+
+// Methods
+
+std::string SparseMatrix::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+SparseMatrix& SparseMatrix::transpose() {
+    // Counting sort by column; walking the rows in order leaves every new row sorted.
+    std::vector<std::size_t> transposedStart(size.columnCount + 1, 0);
+    for(std::size_t column: columnIndex)
+        transposedStart[column + 1]++;
+    std::partial_sum(transposedStart.begin(), transposedStart.end(), transposedStart.begin());
+
+    std::vector<std::size_t> transposedColumn(columnIndex.size());
+    std::vector<double> transposedValues(values.size());
+    std::vector<std::size_t> next(transposedStart.begin(), transposedStart.end() - 1);
+    for(std::size_t i = 0; i < size.rowCount; i++) {
+        for(std::size_t k = rowStart[i]; k < rowStart[i + 1]; k++) {
+            std::size_t slot = next[columnIndex[k]]++;
+            transposedColumn[slot] = i;
+            transposedValues[slot] = values[k];
+        }
+    }
+
+    rowStart = std::move(transposedStart);
+    columnIndex = std::move(transposedColumn);
+    values = std::move(transposedValues);
+    std::swap(size.rowCount, size.columnCount);
+    return *this;
+}
+
+void SparseMatrix::multiply(ConstVectorView vec, VectorView result) const {
+    if(vec.getDimension() != size.columnCount)
+        throw std::invalid_argument("Matrix's column count should be equal to vector's dimension!");
+    if(result.getDimension() != size.rowCount)
+        throw std::invalid_argument("Vector should contain " + std::to_string(size.rowCount) + " Elements");
+
+    // The product reads vec while writing result, so an overlapping result is computed out of place.
+    if(overlaps(vec.data(), (vec.getDimension() - 1) * vec.getStride() + 1,
+                result.data(), (result.getDimension() - 1) * result.getStride() + 1)) {
+        Vector product(size.rowCount);
+        multiply(vec, product);
+        result = product;
+        return;
+    }
+
+    forEachRowRange(rowStart, values.size(), [&](std::size_t firstRow, std::size_t endRow) {
+        for(std::size_t i = firstRow; i < endRow; i++) {
+            double sum = 0.0;
+            for(std::size_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+                sum += values[k] * vec.element(columnIndex[k]);
+            result.data()[i * result.getStride()] = sum;
+        }
+    });
+}
+
+void SparseMatrix::multiply(ConstMatrixView matrix, MatrixView result) const {
+    const MatrixSize& matrixSize = matrix.getDimension();
+    if(matrixSize.rowCount != size.columnCount)
+        throw std::invalid_argument("Left matrix's column count should be equal to right matrix's row count!");
+    if(result.getDimension().rowCount != size.rowCount || result.getDimension().columnCount != matrixSize.columnCount)
+        throw std::invalid_argument("Result matrix should be " + std::to_string(size.rowCount) + "x" +
+                                    std::to_string(matrixSize.columnCount));
+
+    // The row combinations below need contiguous rows on both sides: transposed views go through a copy.
+    if(overlaps(matrix.data(), matrix.getExtent(), result.data(), result.getExtent()) || !result.isRowMajor()) {
+        Matrix product(size.rowCount, matrixSize.columnCount);
+        multiply(matrix, product);
+        result = product.view();
+        return;
+    }
+    if(!matrix.isRowMajor()) {
+        multiply(Matrix(matrix), result);
+        return;
+    }
+
+    // Row i of the result is the combination of the rows of matrix selected by row i's entries.
+    const VectorKernels& kernels = activeVectorKernels();
+    std::size_t columnCount = matrixSize.columnCount;
+    forEachRowRange(rowStart, values.size() * columnCount, [&](std::size_t firstRow, std::size_t endRow) {
+        for(std::size_t i = firstRow; i < endRow; i++) {
+            double* out = result.data() + i * result.getStride();
+            std::fill(out, out + columnCount, 0.0);
+            for(std::size_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+                kernels.axpy(values[k], matrix.data() + columnIndex[k] * matrix.getStride(), out, columnCount);
+        }
+    });
+}
+
+Matrix SparseMatrix::toMatrix() const {
+    Matrix result(size);
+    for(std::size_t i = 0; i < size.rowCount; i++)
+        for(std::size_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+            result[i][columnIndex[k]] = values[k];
+    return result;
+}
+
+std::vector<Triplet> SparseMatrix::toTriplets() const {
+    std::vector<Triplet> triplets;
+    triplets.reserve(values.size());
+    for(std::size_t i = 0; i < size.rowCount; i++)
+        for(std::size_t k = rowStart[i]; k < rowStart[i + 1]; k++)
+            triplets.push_back({i, columnIndex[k], values[k]});
+    return triplets;
+}
+
+// Getters
+
+const MatrixSize& SparseMatrix::getDimension() const {
+    return size;
+}
+
+std::size_t SparseMatrix::getNonZeroCount() const {
+    return values.size();
+}
+
+double SparseMatrix::getElement(std::size_t i, std::size_t j) const {
+    if(i >= size.rowCount || j >= size.columnCount)
+        throw std::invalid_argument("Index out of bound");
+    auto first = columnIndex.begin() + static_cast<std::ptrdiff_t>(rowStart[i]);
+    auto last = columnIndex.begin() + static_cast<std::ptrdiff_t>(rowStart[i + 1]);
+    auto found = std::lower_bound(first, last, j);
+    if(found == last || *found != j)
+        return 0.0;
+    return values[static_cast<std::size_t>(found - columnIndex.begin())];
+}
+
+const std::vector<std::size_t>& SparseMatrix::getRowStarts() const {
+    return rowStart;
+}
+
+const std::vector<std::size_t>& SparseMatrix::getColumnIndices() const {
+    return columnIndex;
+}
+
+const std::vector<double>& SparseMatrix::getValues() const {
+    return values;
+}
+
+// Friend Operators
+
+std::ostream& operator<<(std::ostream& os, const SparseMatrix& matrix) {
+    for(std::size_t i = 0; i < matrix.size.rowCount; i++)
+        for(std::size_t k = matrix.rowStart[i]; k < matrix.rowStart[i + 1]; k++)
+            os << "( " << i << ", " << matrix.columnIndex[k] << " ): " << matrix.values[k] << '\n';
+    return os;
+}
+
+SparseMatrix operator+(const SparseMatrix& lhs, const SparseMatrix& rhs) {
+    if(lhs.size.rowCount != rhs.size.rowCount || lhs.size.columnCount != rhs.size.columnCount)
+        throw std::invalid_argument("Addition of matrices with different sizes are not defined!");
+    return SparseMatrix::merge(lhs, rhs, 1.0);
+}
+
+SparseMatrix operator-(const SparseMatrix& lhs, const SparseMatrix& rhs) {
+    if(lhs.size.rowCount != rhs.size.rowCount || lhs.size.columnCount != rhs.size.columnCount)
+        throw std::invalid_argument("Subtraction of matrices with different sizes are not defined!");
+    return SparseMatrix::merge(lhs, rhs, -1.0);
+}
+
+SparseMatrix operator*(double coeff, const SparseMatrix& matrix) {
+    SparseMatrix result(matrix);
+    result *= coeff;
+    return result;
+}
+
+SparseMatrix operator*(const SparseMatrix& matrix, double coeff) {
+    return coeff * matrix;
+}
+
+Vector operator*(const SparseMatrix& lhs, ConstVectorView rhs) {
+    Vector result(lhs.size.rowCount);
+    lhs.multiply(rhs, result);
+    return result;
+}
+
+Matrix operator*(const SparseMatrix& lhs, ConstMatrixView rhs) {
+    Matrix result(lhs.size.rowCount, rhs.getDimension().columnCount);
+    lhs.multiply(rhs, result);
+    return result;
+}
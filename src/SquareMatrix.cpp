@@ -1,5 +1,28 @@
 #include "SquareMatrix.hpp"
 
+#include "Instrumentation.hpp"
+#include "LUDecomposition.hpp"
+#include "Strassen.hpp"
+#include "Transpose.hpp"
+
+#ifdef LINEAROBJECTS_INSTRUMENTATION
+namespace {
+
+// Nominal FLOP counts for the instrumentation (see Instrumentation.hpp)
+std::size_t luFlops(std::size_t n) {
+    return 2 * n * n * n / 3;
+}
+
+std::size_t powerProducts(std::size_t power) {     // Squarings plus one product per set bit beyond the first
+    std::size_t products = 0;
+    for(std::size_t bits = power; bits > 1; bits >>= 1)
+        products += 1 + (bits & 1);
+    return products;
+}
+
+}
+#endif
+
 // Constructors
 
 SquareMatrix::SquareMatrix(std::size_t n): Matrix(n, n) {
@@ -26,31 +49,47 @@ SquareMatrix::SquareMatrix(const Matrix& matrix) : Matrix(matrix) {
         throw std::invalid_argument("This is not Square Matrix!");
 }
 
+SquareMatrix::SquareMatrix(ConstMatrixView view) : Matrix(view) {
+    if(size.rowCount != size.columnCount)
+        throw std::invalid_argument("This is not Square Matrix!");
+}
+
 // (Move & Copy) (Constructor & Assignment)
 
-SquareMatrix::SquareMatrix(const SquareMatrix &matrix) : Matrix(matrix.data) {}
+SquareMatrix::SquareMatrix(const SquareMatrix &matrix) : Matrix(matrix) {}
 
-SquareMatrix::SquareMatrix(const SquareMatrix &&matrix) noexcept : Matrix(matrix.data){}
+SquareMatrix::SquareMatrix(SquareMatrix &&matrix) noexcept : Matrix(std::move(matrix)){}
 
 SquareMatrix &SquareMatrix::operator=(const SquareMatrix &matrix) {
-    size.rowCount = matrix.size.rowCount;
-    data = matrix.data;
+    Matrix::operator=(matrix);
     return *this;
 }
 
-SquareMatrix &SquareMatrix::operator=(SquareMatrix &&matrix) noexcept {
-    size.rowCount = matrix.size.rowCount;
-    data = matrix.data;
+SquareMatrix &SquareMatrix::operator=(SquareMatrix &&matrix) {
+    Matrix::operator=(std::move(matrix));
+    return *this;
+}
+
+// Compound Assignment
+
+SquareMatrix &SquareMatrix::operator*=(double coeff) {
+    Matrix::operator*=(coeff);
     return *this;
 }
 
 // Methods
 
-SquareMatrix& SquareMatrix::transpose() {
-    for(std::size_t i = 0; i < size.rowCount; i++)
-        for(std::size_t j = 0; j < i; j++)
-            std::swap(data[i][j], data[j][i]);
+SquareMatrix SquareMatrix::identity(std::size_t n) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixIdentity);
+    SquareMatrix result(n);
+    for(std::size_t i = 0; i < n; i++)
+        result.data[i * result.stride + i] = 1;
+    return result;
+}
 
+SquareMatrix& SquareMatrix::transpose() {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixTranspose, 0, size.rowCount * size.rowCount * sizeof(double));
+    transposeSquareInPlace(size.rowCount, data.data(), stride);
     return *this;
 }
 
@@ -64,6 +103,32 @@ SquareMatrix& SquareMatrix::swapColumns(std::size_t idx1, std::size_t idx2) {
     return *this;
 }
 
+LUDecomposition SquareMatrix::lu() const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixLU, luFlops(size.rowCount));
+    return LUDecomposition(*this);
+}
+
+double SquareMatrix::determinant() const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixDeterminant, luFlops(size.rowCount));
+    return lu().determinant();
+}
+
+SquareMatrix SquareMatrix::inverse() const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixInverse, 2 * size.rowCount * size.rowCount * size.rowCount);
+    return lu().inverse();
+}
+
+Vector SquareMatrix::solve(ConstVectorView rhs) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixSolve, luFlops(size.rowCount) + 2 * size.rowCount * size.rowCount);
+    return lu().solve(rhs);
+}
+
+Matrix SquareMatrix::solve(ConstMatrixView rhs) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixSolve,
+                             luFlops(size.rowCount) + 2 * size.rowCount * size.rowCount * rhs.getDimension().columnCount);
+    return lu().solve(rhs);
+}
+
 // Setters
 
 SquareMatrix& SquareMatrix::setRow(std::size_t idx, const Vector &row) {
@@ -89,34 +154,53 @@ SquareMatrix &SquareMatrix::setSubColumn(std::size_t idx, std::size_t rowStart,
 // Friend Operators
 
 SquareMatrix operator*(const SquareMatrix &lhs, const SquareMatrix &rhs) {
-    SquareMatrix result( static_cast<Matrix>(lhs) * static_cast<Matrix>(rhs) ); // Casting for Avoiding Recursion!
-    return result;
-}
-
-SquareMatrix operator^(const SquareMatrix &matrix, std::size_t power) {
-    if( power == 0 ) {
-        SquareMatrix result(matrix.size.rowCount);
-        for(std::size_t i = 0; i < result.size.rowCount; i++)
-            result[i][i] = 1;
-        return result;
-    } else {
-        SquareMatrix result(matrix);
-        for(std::size_t i = 1; i < power; i++)
-            result = result * matrix;
-        return result;
-    }
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixMultiply, 2 * lhs.size.rowCount * lhs.size.rowCount * rhs.size.columnCount);
+    std::size_t threshold = strassenThreshold();
+    if(threshold != 0 && lhs.size.rowCount >= threshold)
+        return strassenMultiply(lhs, rhs);
 
+    SquareMatrix result( static_cast<const Matrix&>(lhs) * static_cast<const Matrix&>(rhs) ); // Casting for Avoiding Recursion!
+    return result;
 }
 
-SquareMatrix operator*(const SquareMatrix &lhs, double coeff) {
-    return SquareMatrix(coeff * static_cast<const Matrix&>(lhs));
-}
+SquareMatrix strassenMultiply(const SquareMatrix &lhs, const SquareMatrix &rhs) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::StrassenMultiply, 2 * lhs.size.rowCount * lhs.size.rowCount * rhs.size.columnCount);
+    if(lhs.size.rowCount != rhs.size.rowCount)
+        throw std::invalid_argument("Left matrix's column count should be equal to right matrix's row count!");
 
-SquareMatrix operator*(double coeff, const SquareMatrix &lhs) {
-    return SquareMatrix(coeff * static_cast<const Matrix&>(lhs));
+    SquareMatrix result(lhs.size.rowCount);
+    strassenGemm(lhs.size.rowCount, lhs.data.data(), lhs.stride, rhs.data.data(), rhs.stride,
+                 result.data.data(), result.stride, strassenCutoff());
+    return result;
 }
 
-SquareMatrix operator+(const SquareMatrix &lhs, const SquareMatrix &rhs) {
-    return SquareMatrix(static_cast<const Matrix&>(lhs) + static_cast<const Matrix&>(rhs));
+// Exponentiation by squaring: about log2(power) squarings plus one product per set bit.
+// Every product is written into a preallocated scratch matrix and swapped in, so no temporaries are created.
+SquareMatrix operator^(const SquareMatrix &matrix, std::size_t power) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::SquareMatrixPower, powerProducts(power) * 2 * matrix.size.rowCount * matrix.size.rowCount * matrix.size.rowCount);
+    if( power == 0 )
+        return SquareMatrix::identity(matrix.size.rowCount);
+
+    SquareMatrix base(matrix);
+    SquareMatrix result(matrix.size.rowCount);
+    SquareMatrix scratch(matrix.size.rowCount);
+    bool first(true);
+    while(true) {
+        if(power & 1) {
+            if(first) {
+                result = base;
+                first = false;
+            } else {
+                gemm(1.0, result, base, 0.0, scratch);
+                std::swap(result, scratch);
+            }
+        }
+        power >>= 1;
+        if(power == 0)
+            break;
+        gemm(1.0, base, base, 0.0, scratch);
+        std::swap(base, scratch);
+    }
+    return result;
 }
 
@@ -0,0 +1,129 @@
+#include "Strassen.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+#include "AlignedAllocator.hpp"
+#include "Gemm.hpp"
+
+namespace {
+
+// out = x + sign * y over h x h blocks
+void combine(std::size_t h, const double* x, std::size_t ldx, const double* y, std::size_t ldy,
+             double sign, double* out, std::size_t ldo) {
+    for(std::size_t i = 0; i < h; i++) {
+        const double* xRow = x + i * ldx;
+        const double* yRow = y + i * ldy;
+        double* outRow = out + i * ldo;
+        for(std::size_t j = 0; j < h; j++)
+            outRow[j] = xRow[j] + sign * yRow[j];
+    }
+}
+
+void classical(std::size_t m, std::size_t n, std::size_t k, const double* a, std::size_t lda,
+               const double* b, std::size_t ldb, double beta, double* c, std::size_t ldc) {
+    blockedGemm({m, n, k}, 1.0, {a, lda, 1}, {b, ldb, 1}, beta, {c, ldc});
+}
+
+std::size_t workspaceSize(std::size_t n, std::size_t cutoff) {
+    std::size_t size = 0;
+    while(n > cutoff) {
+        std::size_t h = (n - (n & 1)) / 2;
+        size += 2 * h * h;
+        n = h;
+    }
+    return size;
+}
+
+void multiply(std::size_t n, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+              double* c, std::size_t ldc, std::size_t cutoff, double* workspace) {
+    if(n <= cutoff) {
+        classical(n, n, n, a, lda, b, ldb, 0.0, c, ldc);
+        return;
+    }
+
+    std::size_t m = n - (n & 1);
+    std::size_t h = m / 2;
+
+    const double* a11 = a;
+    const double* a12 = a + h;
+    const double* a21 = a + h * lda;
+    const double* a22 = a21 + h;
+    const double* b11 = b;
+    const double* b12 = b + h;
+    const double* b21 = b + h * ldb;
+    const double* b22 = b21 + h;
+    double* c11 = c;
+    double* c12 = c + h;
+    double* c21 = c + h * ldc;
+    double* c22 = c21 + h;
+
+    double* x = workspace;
+    double* y = workspace + h * h;
+    double* deeper = y + h * h;
+
+    // Winograd's variant with two temporaries (Boyer, Dumas, Pernet, Zhou 2009, table for C = AB)
+    combine(h, a11, lda, a21, lda, -1.0, x, h);             // S3 = A11 - A21
+    combine(h, b22, ldb, b12, ldb, -1.0, y, h);             // T3 = B22 - B12
+    multiply(h, x, h, y, h, c21, ldc, cutoff, deeper);      // P7 = S3 T3
+    combine(h, a21, lda, a22, lda, 1.0, x, h);              // S1 = A21 + A22
+    combine(h, b12, ldb, b11, ldb, -1.0, y, h);             // T1 = B12 - B11
+    multiply(h, x, h, y, h, c22, ldc, cutoff, deeper);      // P5 = S1 T1
+    combine(h, x, h, a11, lda, -1.0, x, h);                 // S2 = S1 - A11
+    combine(h, b22, ldb, y, h, -1.0, y, h);                 // T2 = B22 - T1
+    multiply(h, x, h, y, h, c12, ldc, cutoff, deeper);      // P6 = S2 T2
+    combine(h, a12, lda, x, h, -1.0, x, h);                 // S4 = A12 - S2
+    multiply(h, x, h, b22, ldb, c11, ldc, cutoff, deeper);  // P3 = S4 B22
+    multiply(h, a11, lda, b11, ldb, x, h, cutoff, deeper);  // P1 = A11 B11
+    combine(h, x, h, c12, ldc, 1.0, c12, ldc);              // U2 = P1 + P6
+    combine(h, c12, ldc, c21, ldc, 1.0, c21, ldc);          // U3 = U2 + P7
+    combine(h, c12, ldc, c22, ldc, 1.0, c12, ldc);          // U4 = U2 + P5
+    combine(h, c21, ldc, c22, ldc, 1.0, c22, ldc);          // U7 = U3 + P5     -> C22
+    combine(h, c12, ldc, c11, ldc, 1.0, c12, ldc);          // U5 = U4 + P3     -> C12
+    combine(h, y, h, b21, ldb, -1.0, y, h);                 // T4 = T2 - B21
+    multiply(h, a22, lda, y, h, c11, ldc, cutoff, deeper);  // P4 = A22 T4
+    combine(h, c21, ldc, c11, ldc, -1.0, c21, ldc);         // U6 = U3 - P4     -> C21
+    multiply(h, a12, lda, b21, ldb, c11, ldc, cutoff, deeper);  // P2 = A12 B21
+    combine(h, x, h, c11, ldc, 1.0, c11, ldc);              // U1 = P1 + P2     -> C11
+
+    if(m == n)
+        return;
+
+    // Peel the odd row and column: C[0:m, 0:m] += A[0:m, m] B[m, 0:m], then the last column and row of C.
+    classical(m, m, 1, a + m, lda, b + m * ldb, ldb, 1.0, c, ldc);
+    classical(n, 1, n, a, lda, b + m, ldb, 0.0, c + m, ldc);
+    classical(1, m, n, a + m * lda, lda, b, ldb, 0.0, c + m * ldc, ldc);
+}
+
+std::atomic<std::size_t> strassenThresholdSetting{0};
+std::atomic<std::size_t> strassenCutoffSetting{256};
+
+}
+
+void setStrassenThreshold(std::size_t threshold) {
+    strassenThresholdSetting.store(threshold, std::memory_order_relaxed);
+}
+
+std::size_t strassenThreshold() {
+    return strassenThresholdSetting.load(std::memory_order_relaxed);
+}
+
+void setStrassenCutoff(std::size_t cutoff) {
+    strassenCutoffSetting.store(cutoff, std::memory_order_relaxed);
+}
+
+std::size_t strassenCutoff() {
+    return strassenCutoffSetting.load(std::memory_order_relaxed);
+}
+
+void strassenGemm(std::size_t n, const double* a, std::size_t lda, const double* b, std::size_t ldb,
+                  double* c, std::size_t ldc, std::size_t cutoff) {
+    if(n == 0)
+        return;
+    cutoff = std::max<std::size_t>(cutoff, 1);
+
+    // Kept across calls, so never taken from a scoped arena (MemoryResource.hpp)
+    thread_local AlignedBuffer workspace{AlignedAllocator<double>(alignedHeapResource())};
+    workspace.resize(std::max(workspace.size(), workspaceSize(n, cutoff)));
+    multiply(n, a, lda, b, ldb, c, ldc, cutoff, workspace.data());
+}
@@ -0,0 +1,224 @@
+#include "SymmetricMatrix.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "CholeskyDecomposition.hpp"
+#include "Gemm.hpp"
+#include "ThreadPool.hpp"
+#include "VectorKernels.hpp"
+
+namespace {
+
+constexpr std::size_t TILE = 64;
+
+// Products touching fewer elements of the matrix than this run on the calling thread only.
+constexpr std::size_t PARALLEL_THRESHOLD = 256 * 256;
+
+// Runs body(0) ... body(count - 1), on the thread pool for large matrices. Each index writes its own
+// rows of the result, summing in a fixed order, so results do not depend on the thread count.
+template<typename Body>
+void forEachTileRow(std::size_t count, std::size_t elements, const Body& body) {
+    if(count == 1 || elements < PARALLEL_THRESHOLD) {
+        for(std::size_t I = 0; I < count; I++)
+            body(I);
+        return;
+    }
+    ThreadPool::instance().parallelFor(count, body);
+}
+
+}
+
+// Constructors
+
+SymmetricMatrix::SymmetricMatrix(std::size_t size) : n(size) {
+    if(n == 0)
+        throw std::invalid_argument("Condition didn't match (size > 0)");
+    // As few tiles as with TILE-row ones, shrunk to share the rows evenly: the last tile is never mostly padding
+    tileCount = (n + TILE - 1) / TILE;
+    tileSize = (n + tileCount - 1) / tileCount;
+    data.resize((tileCount * (tileCount + 1)) / 2 * tileSize * tileSize);
+}
+
+SymmetricMatrix::SymmetricMatrix(ConstMatrixView matrix) : SymmetricMatrix(matrix.getDimension().rowCount) {
+    if(matrix.getDimension().columnCount != n)
+        throw std::invalid_argument("This is not Square Matrix!");
+    for(std::size_t i = 0; i < n; i++)
+        for(std::size_t j = 0; j <= i; j++)
+            setElement(i, j, matrix.element(i, j));
+}
+
+// Compound Assignment
+
+SymmetricMatrix& SymmetricMatrix::operator+=(const SymmetricMatrix& rhs) {
+    if(rhs.n != n)
+        throw std::invalid_argument("Addition of matrices with different sizes are not defined!");
+    activeVectorKernels().add(data.data(), rhs.data.data(), data.data(), data.size());
+    return *this;
+}
+
+SymmetricMatrix& SymmetricMatrix::operator-=(const SymmetricMatrix& rhs) {
+    if(rhs.n != n)
+        throw std::invalid_argument("Subtraction of matrices with different sizes are not defined!");
+    activeVectorKernels().axpy(-1.0, rhs.data.data(), data.data(), data.size());
+    return *this;
+}
+
+SymmetricMatrix& SymmetricMatrix::operator*=(double coeff) {
+    activeVectorKernels().scale(data.data(), coeff, data.data(), data.size());
+    return *this;
+}
+
+// Methods
+
+std::size_t SymmetricMatrix::offset(std::size_t i, std::size_t j) const {
+    return static_cast<std::size_t>(tile(i / tileSize, j / tileSize) - data.data()) +
+           (i % tileSize) * tileSize + j % tileSize;
+}
+
+std::string SymmetricMatrix::toString() const {
+    std::ostringstream os;
+    os << *this;
+    return os.str();
+}
+
+SquareMatrix SymmetricMatrix::toSquareMatrix() const {
+    SquareMatrix result(n);
+    for(std::size_t i = 0; i < n; i++)
+        for(std::size_t j = 0; j <= i; j++)
+            result[i][j] = result[j][i] = data[offset(i, j)];
+    return result;
+}
+
+CholeskyDecomposition SymmetricMatrix::cholesky() const {
+    return CholeskyDecomposition(*this);
+}
+
+// y_I = sum over J <= I of A_IJ x_J (row dots) + sum over J > I of A_JI^T x_J (row axpys)
+void SymmetricMatrix::multiply(ConstVectorView vec, VectorView result) const {
+    if(vec.getDimension() != n)
+        throw std::invalid_argument("Matrix's column count should be equal to vector's dimension!");
+    if(result.getDimension() != n)
+        throw std::invalid_argument("Vector should contain " + std::to_string(n) + " Elements");
+
+    // The tiles are applied with the SIMD kernels, which want contiguous operands that do not overlap.
+    if(vec.getStride() != 1 || result.getStride() != 1 || overlaps(vec.data(), n, result.data(), n)) {
+        Vector product(n);
+        multiply(Vector(vec), product);
+        result = product;
+        return;
+    }
+
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachTileRow(tileCount, data.size(), [&](std::size_t I) {
+        std::size_t rows = tileExtent(I);
+        double* out = result.data() + I * tileSize;
+        std::fill(out, out + rows, 0.0);
+        for(std::size_t J = 0; J <= I; J++) {
+            const double* block = tile(I, J);
+            const double* x = vec.data() + J * tileSize;
+            for(std::size_t r = 0; r < rows; r++)
+                out[r] += kernels.dot(block + r * tileSize, x, tileExtent(J));
+        }
+        for(std::size_t J = I + 1; J < tileCount; J++) {
+            const double* block = tile(J, I);
+            const double* x = vec.data() + J * tileSize;
+            for(std::size_t r = 0; r < tileExtent(J); r++)
+                kernels.axpy(x[r], block + r * tileSize, out, rows);
+        }
+    });
+}
+
+// R_I = sum over J <= I of A_IJ B_J + sum over J > I of A_JI^T B_J, one multiply-kernel call per tile
+void SymmetricMatrix::multiply(ConstMatrixView matrix, MatrixView result) const {
+    const MatrixSize& matrixSize = matrix.getDimension();
+    if(matrixSize.rowCount != n)
+        throw std::invalid_argument("Left matrix's column count should be equal to right matrix's row count!");
+    if(result.getDimension().rowCount != n || result.getDimension().columnCount != matrixSize.columnCount)
+        throw std::invalid_argument("Result matrix should be " + std::to_string(n) + "x" +
+                                    std::to_string(matrixSize.columnCount));
+
+    // The kernel writes row-major blocks, so a transposed result is filled through a temporary as well
+    if(overlaps(matrix.data(), matrix.getExtent(), result.data(), result.getExtent()) || !result.isRowMajor()) {
+        Matrix product(n, matrixSize.columnCount);
+        multiply(matrix, product);
+        result = product.view();
+        return;
+    }
+
+    std::size_t columnCount = matrixSize.columnCount;
+    forEachTileRow(tileCount, data.size() * columnCount, [&](std::size_t I) {
+        GemmResult out{result.data() + I * tileSize * result.getStride(), result.getStride()};
+        for(std::size_t J = 0; J < tileCount; J++) {
+            GemmOperand block = J <= I ? GemmOperand{tile(I, J), tileSize, 1} : GemmOperand{tile(J, I), 1, tileSize};
+            GemmOperand rows{matrix.data() + J * tileSize * matrix.getStride(), matrix.getStride(), matrix.getColumnStride()};
+            blockedGemm(GemmShape{tileExtent(I), columnCount, tileExtent(J)}, 1.0, block, rows, J == 0 ? 0.0 : 1.0, out);
+        }
+    });
+}
+
+// Getters
+
+std::size_t SymmetricMatrix::getDimension() const {
+    return n;
+}
+
+double SymmetricMatrix::getElement(std::size_t i, std::size_t j) const {
+    if(i >= n || j >= n)
+        throw std::invalid_argument("Index out of bound");
+    return i >= j ? data[offset(i, j)] : data[offset(j, i)];
+}
+
+// Setters
+
+SymmetricMatrix& SymmetricMatrix::setElement(std::size_t i, std::size_t j, double value) {
+    if(i >= n || j >= n)
+        throw std::invalid_argument("Index out of bound");
+    if(i < j)
+        std::swap(i, j);
+    data[offset(i, j)] = value;
+    if(i / tileSize == j / tileSize)     // Diagonal tiles hold both triangles
+        data[offset(j, i)] = value;
+    return *this;
+}
+
+// Friend Operators
+
+std::ostream& operator<<(std::ostream& os, const SymmetricMatrix& matrix) {
+    return os << matrix.toSquareMatrix();
+}
+
+SymmetricMatrix operator+(const SymmetricMatrix& lhs, const SymmetricMatrix& rhs) {
+    SymmetricMatrix result(lhs);
+    result += rhs;
+    return result;
+}
+
+SymmetricMatrix operator-(const SymmetricMatrix& lhs, const SymmetricMatrix& rhs) {
+    SymmetricMatrix result(lhs);
+    result -= rhs;
+    return result;
+}
+
+SymmetricMatrix operator*(double coeff, const SymmetricMatrix& matrix) {
+    SymmetricMatrix result(matrix);
+    result *= coeff;
+    return result;
+}
+
+SymmetricMatrix operator*(const SymmetricMatrix& matrix, double coeff) {
+    return coeff * matrix;
+}
+
+Vector operator*(const SymmetricMatrix& lhs, ConstVectorView rhs) {
+    Vector result(lhs.n);
+    lhs.multiply(rhs, result);
+    return result;
+}
+
+Matrix operator*(const SymmetricMatrix& lhs, ConstMatrixView rhs) {
+    Matrix result(lhs.n, rhs.getDimension().columnCount);
+    lhs.multiply(rhs, result);
+    return result;
+}
@@ -0,0 +1,187 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+#include <utility>
+
+namespace {
+
+thread_local bool insidePoolTask = false;
+
+std::size_t defaultThreadCount() {
+    if(const char* env = std::getenv("LINEAROBJECTS_THREADS")) {
+        try {
+            std::size_t count = std::stoul(env);
+            if(count > 0)
+                return count;
+        } catch(const std::exception&) {
+            // Fall through to the hardware default on malformed values.
+        }
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}
+
+// Constructors
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    startWorkers(threadCount);
+}
+
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool(defaultThreadCount());
+    return pool;
+}
+
+// Methods
+
+void ThreadPool::setThreadCount(std::size_t threadCount) {
+    if(threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    std::lock_guard<std::mutex> batchLock(batchMutex);
+    if(threadCount == queues.size())
+        return;
+    stopWorkers();
+    startWorkers(threadCount);
+}
+
+// Readable from any thread while setThreadCount() rebuilds the queues
+std::size_t ThreadPool::getThreadCount() const {
+    return threadCount.load(std::memory_order_relaxed);
+}
+
+void ThreadPool::run(std::size_t taskCount, TaskRef task) {
+    if(taskCount == 0)
+        return;
+    if(insidePoolTask || taskCount == 1) {
+        for(std::size_t i = 0; i < taskCount; i++)
+            task.invoke(task.task, i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> batchLock(batchMutex);
+    if(workers.empty()) {
+        for(std::size_t i = 0; i < taskCount; i++)
+            task.invoke(task.task, i);
+        return;
+    }
+
+    // Contiguous index ranges per thread keep neighbouring tiles on the same core until stealing kicks in.
+    currentTask = task;
+    failure = nullptr;
+    remaining = taskCount;
+    std::size_t queueCount = queues.size();
+    for(std::size_t q = 0; q < queueCount; q++) {
+        std::lock_guard<std::mutex> queueLock(queues[q]->mutex);
+        queues[q]->begin = q * taskCount / queueCount;
+        queues[q]->end = (q + 1) * taskCount / queueCount;
+    }
+
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        generation++;
+    }
+    wakeWorkers.notify_all();
+
+    drain(0);
+
+    std::unique_lock<std::mutex> stateLock(stateMutex);
+    batchDone.wait(stateLock, [this]{ return remaining == 0; });
+    currentTask = TaskRef{};
+    if(failure)
+        std::rethrow_exception(std::exchange(failure, nullptr));
+}
+
+void ThreadPool::startWorkers(std::size_t count) {
+    stopping = false;
+    for(std::size_t q = 0; q < count; q++)
+        queues.push_back(std::make_unique<WorkerQueue>());
+    for(std::size_t q = 1; q < count; q++)
+        workers.emplace_back(&ThreadPool::workerLoop, this, q);
+    threadCount.store(count, std::memory_order_relaxed);
+}
+
+void ThreadPool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        stopping = true;
+    }
+    wakeWorkers.notify_all();
+    for(auto& worker: workers)
+        worker.join();
+    workers.clear();
+    queues.clear();
+}
+
+void ThreadPool::workerLoop(std::size_t queueIdx) {
+    insidePoolTask = true;
+    std::size_t seenGeneration = 0;
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        seenGeneration = generation;
+    }
+
+    while(true) {
+        {
+            std::unique_lock<std::mutex> stateLock(stateMutex);
+            wakeWorkers.wait(stateLock, [&]{ return stopping || generation != seenGeneration; });
+            if(stopping)
+                return;
+            seenGeneration = generation;
+        }
+        drain(queueIdx);
+    }
+}
+
+void ThreadPool::drain(std::size_t queueIdx) {
+    bool wasInside = insidePoolTask;
+    insidePoolTask = true;
+
+    std::size_t task{};
+    while(popTask(queueIdx, task)) {
+        // The queue mutex taken by popTask() orders this read after the caller published currentTask.
+        try {
+            currentTask.invoke(currentTask.task, task);
+        } catch(...) {
+            std::lock_guard<std::mutex> stateLock(stateMutex);
+            if(!failure)
+                failure = std::current_exception();
+        }
+        if(remaining.fetch_sub(1) == 1) {
+            std::lock_guard<std::mutex> stateLock(stateMutex);
+            batchDone.notify_all();
+        }
+    }
+
+    insidePoolTask = wasInside;
+}
+
+bool ThreadPool::popTask(std::size_t queueIdx, std::size_t& task) {
+    {
+        WorkerQueue& own = *queues[queueIdx];
+        std::lock_guard<std::mutex> queueLock(own.mutex);
+        if(own.begin < own.end) {
+            task = own.begin++;
+            return true;
+        }
+    }
+
+    for(std::size_t offset = 1; offset < queues.size(); offset++) {
+        WorkerQueue& victim = *queues[(queueIdx + offset) % queues.size()];
+        std::lock_guard<std::mutex> queueLock(victim.mutex);
+        if(victim.begin < victim.end) {
+            task = --victim.end;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Destructor
+
+ThreadPool::~ThreadPool() {
+    stopWorkers();
+}
@@ -0,0 +1,118 @@
+#include "Transpose.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// 32 x 32 doubles per side keeps both the source and destination tiles (16 KB) in L1.
+constexpr std::size_t TILE = 32;
+
+// Moves every element to destination(idx), one permutation cycle at a time.
+template<typename T, typename Destination>
+void permuteInPlace(T* data, std::size_t count, const Destination& destination) {
+    std::vector<bool> moved(count);
+    for(std::size_t start = 0; start < count; start++) {
+        if(moved[start])
+            continue;
+        T carried = data[start];
+        std::size_t idx = start;
+        do {
+            idx = destination(idx);
+            std::swap(carried, data[idx]);
+            moved[idx] = true;
+        } while(idx != start);
+    }
+}
+
+}
+
+template<typename T>
+void transposeOutOfPlace(std::size_t rowCount, std::size_t columnCount,
+                         const T* src, std::size_t srcStride, T* dst, std::size_t dstStride) {
+    if(rowCount <= TILE && columnCount <= TILE) {
+        for(std::size_t i = 0; i < rowCount; i++)
+            for(std::size_t j = 0; j < columnCount; j++)
+                dst[j * dstStride + i] = src[i * srcStride + j];
+        return;
+    }
+
+    if(rowCount >= columnCount) {
+        std::size_t half = rowCount / 2;
+        transposeOutOfPlace(half, columnCount, src, srcStride, dst, dstStride);
+        transposeOutOfPlace(rowCount - half, columnCount, src + half * srcStride, srcStride, dst + half, dstStride);
+    } else {
+        std::size_t half = columnCount / 2;
+        transposeOutOfPlace(rowCount, half, src, srcStride, dst, dstStride);
+        transposeOutOfPlace(rowCount, columnCount - half, src + half, srcStride, dst + half * dstStride, dstStride);
+    }
+}
+
+template<typename T>
+void transposeSquareInPlace(std::size_t n, T* data, std::size_t stride) {
+    for(std::size_t ib = 0; ib < n; ib += TILE) {
+        std::size_t iEnd = std::min(n, ib + TILE);
+        for(std::size_t jb = ib; jb < n; jb += TILE) {
+            std::size_t jEnd = std::min(n, jb + TILE);
+            for(std::size_t i = ib; i < iEnd; i++)
+                for(std::size_t j = std::max(jb, i + 1); j < jEnd; j++)
+                    std::swap(data[i * stride + j], data[j * stride + i]);
+        }
+    }
+}
+
+template<typename T>
+void transposeInPlace(std::size_t rowCount, std::size_t columnCount, T* data) {
+    if(rowCount == columnCount) {
+        transposeSquareInPlace(rowCount, data, columnCount);
+        return;
+    }
+    if(rowCount == 1 || columnCount == 1)
+        return;
+
+    // (i, j) at i * columnCount + j moves to (j, i) at j * rowCount + i
+    permuteInPlace(data, rowCount * columnCount, [rowCount, columnCount](std::size_t idx) {
+        return (idx % columnCount) * rowCount + idx / columnCount;
+    });
+}
+
+template<typename T>
+void rotateSquareInPlace(std::size_t n, T* data, std::size_t stride) {
+    auto at = [data, stride](std::size_t i, std::size_t j) -> T& { return data[i * stride + j]; };
+    for(std::size_t i = 0; i < n / 2; i++) {
+        for(std::size_t j = i; j < n - 1 - i; j++) {
+            T carried = at(i, j);
+            at(i, j) = at(n - 1 - j, i);
+            at(n - 1 - j, i) = at(n - 1 - i, n - 1 - j);
+            at(n - 1 - i, n - 1 - j) = at(j, n - 1 - i);
+            at(j, n - 1 - i) = carried;
+        }
+    }
+}
+
+template<typename T>
+void rotateInPlace(std::size_t rowCount, std::size_t columnCount, T* data) {
+    if(rowCount == columnCount) {
+        rotateSquareInPlace(rowCount, data, columnCount);
+        return;
+    }
+
+    // (i, j) moves to (j, rowCount - 1 - i) of the columnCount x rowCount result
+    permuteInPlace(data, rowCount * columnCount, [rowCount, columnCount](std::size_t idx) {
+        return (idx % columnCount) * rowCount + (rowCount - 1 - idx / columnCount);
+    });
+}
+
+#define LINEAROBJECTS_INSTANTIATE_TRANSPOSE(T) \
+    template void transposeOutOfPlace(std::size_t, std::size_t, const T*, std::size_t, T*, std::size_t); \
+    template void transposeSquareInPlace(std::size_t, T*, std::size_t); \
+    template void transposeInPlace(std::size_t, std::size_t, T*); \
+    template void rotateSquareInPlace(std::size_t, T*, std::size_t); \
+    template void rotateInPlace(std::size_t, std::size_t, T*);
+
+LINEAROBJECTS_INSTANTIATE_TRANSPOSE(double)
+LINEAROBJECTS_INSTANTIATE_TRANSPOSE(float)
+LINEAROBJECTS_INSTANTIATE_TRANSPOSE(int)
+
+#undef LINEAROBJECTS_INSTANTIATE_TRANSPOSE
@@ -1,72 +1,162 @@
 #include "Vector.hpp"
+#include "Instrumentation.hpp"
 #include "Matrix.hpp"
+#include "VectorKernels.hpp"
+
+namespace {
+    // float: SIMD kernel with double accumulation (see Scalar.hpp)
+    template<typename T>
+    Accumulator<T> dotProduct(const T* lhs, const T* rhs, std::size_t n) {
+        if constexpr(std::is_same_v<T, double>) {
+            return activeVectorKernels().dot(lhs, rhs, n);
+        } else if constexpr(std::is_same_v<T, float>) {
+            return activeVectorKernels().dotFloat(lhs, rhs, n);
+        } else {
+            Accumulator<T> sum = 0;
+            for(std::size_t i = 0; i < n; i++)
+                sum += static_cast<Accumulator<T>>(lhs[i]) * rhs[i];
+            return sum;
+        }
+    }
+}
 
 // Constructors
 
-Vector::Vector(std::size_t size) {
+template<typename T>
+BasicVector<T>::BasicVector(std::size_t size) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorConstruct);
+    n = size;
+    comps.resize(n);
+}
+
+template<typename T>
+BasicVector<T>::BasicVector(std::size_t size, std::pmr::memory_resource* resource) : comps(AlignedAllocator<T>(resource)) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorConstruct);
     n = size;
     comps.resize(n);
 }
 
-Vector::Vector(std::initializer_list<double> components) {
+template<typename T>
+BasicVector<T>::BasicVector(std::initializer_list<T> components) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorConstruct, 0, components.size() * sizeof(T));
     n = components.size();
     for(auto i: components)
         comps.push_back(i);
 }
 
-Vector::Vector(const std::vector<double>& components) {
+template<typename T>
+BasicVector<T>::BasicVector(const std::vector<T>& components) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorConstruct, 0, components.size() * sizeof(T));
     n = components.size();
     for(auto i: components)
         comps.push_back(i);
 }
 
-Vector::Vector(const Vector& vec) {
-    n = vec.n;
-    comps = vec.comps;
+template<typename T>
+BasicVector<T>::BasicVector(BasicAlignedBuffer<T>&& components) noexcept : comps(std::move(components)) {
+    n = comps.size();
 }
 
-Vector::Vector(const Vector&& vec)  noexcept {
+template<typename T>
+BasicVector<T>::BasicVector(const T* first, const T* last) {
+    n = static_cast<std::size_t>(last - first);
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorConstruct, 0, n * sizeof(T));
+    comps.assign(first, last);
+}
+
+template<typename T>
+BasicVector<T>::BasicVector(BasicVectorView<const T> view) {
+    n = view.getDimension();
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorConstruct, 0, n * sizeof(T));
+    comps.resize(n);
+    for(std::size_t i = 0; i < n; i++)
+        comps[i] = view.element(i);
+}
+
+template<typename T>
+BasicVector<T>::BasicVector(const BasicVector& vec) : VectorExpression<BasicVector<T>>() {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorCopy, 0, vec.n * sizeof(T));
     n = vec.n;
     comps = vec.comps;
 }
 
-Vector& Vector::operator=(const Vector& rhs) {
+template<typename T>
+BasicVector<T>::BasicVector(BasicVector&& vec) noexcept : VectorExpression<BasicVector<T>>(), comps(std::move(vec.comps)) {
+    n = std::exchange(vec.n, 0);
+}
+
+template<typename T>
+BasicVector<T>& BasicVector<T>::operator=(const BasicVector& rhs) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorCopy, 0, rhs.n * sizeof(T));
     n = rhs.n;
     comps = rhs.comps;
     return *this;
 }
 
-Vector& Vector::operator=(Vector&& rhs) noexcept {
-    n = rhs.n;
-    comps = rhs.comps;
+// The buffer's resource never propagates (see AlignedAllocator.hpp): the buffer is stolen only when both
+// vectors allocate from equal resources, otherwise it is copied into this one's and rhs is left as it was.
+template<typename T>
+BasicVector<T>& BasicVector<T>::operator=(BasicVector&& rhs) {
+    if(comps.get_allocator() != rhs.comps.get_allocator())
+        return *this = rhs;
+    n = std::exchange(rhs.n, 0);
+    comps = std::move(rhs.comps);
+    return *this;
+}
+
+// Compound Assignment
+
+template<typename T>
+BasicVector<T>& BasicVector<T>::operator*=(double coeff) {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorScale, n);
+    if constexpr(std::is_same_v<T, double>) {
+        activeVectorKernels().scale(comps.data(), coeff, comps.data(), n);
+    } else {
+        for(std::size_t i = 0; i < n; i++)
+            comps[i] = roundToScalar<T>(coeff * comps[i]);
+    }
     return *this;
 }
 
 // Methods
 
-std::string Vector::toString() const {
+template<typename T>
+std::string BasicVector<T>::toString() const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorToString);
     std::ostringstream result{};
     result << *this;
     return result.str();
 }
 
-double Vector::magnitude() const {
-    return sqrt((*this) * (*this));
+template<typename T>
+double BasicVector<T>::magnitude() const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorMagnitude, 2 * n);
+    return sqrt(static_cast<double>(dot(*this)));
+}
+
+template<typename T>
+double BasicVector<T>::magnitude(ExecutionPolicy policy) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorMagnitude, 2 * n);
+    return sqrt(static_cast<double>(dot(policy, *this)));
 }
 
-std::size_t Vector::getDimension() const {
-    return n;
+template<typename T>
+std::pmr::memory_resource* BasicVector<T>::getMemoryResource() const {
+    return comps.get_allocator().getResource();
 }
 
-double Vector::angle(const Vector &rhs) const{
-    double dotProduct = (*this) * rhs;
+template<typename T>
+double BasicVector<T>::angle(const BasicVector &rhs) const{
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorAngle, 6 * n);
+    auto dotProduct = static_cast<double>(dot(rhs));
     double magnitudes = this->magnitude() * rhs.magnitude();
     return acos(dotProduct/magnitudes);
 }
 
-Matrix Vector::getMatrix(VectorType vType) const {
-    std::vector<std::vector<double>> v{ comps };
-    Matrix m (v);
+template<typename T>
+BasicMatrix<T> BasicVector<T>::getMatrix(VectorType vType) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorGetMatrix, 0, n * sizeof(T));
+    BasicMatrix<T> m(BasicMatrixView<const T>(comps.data(), 1, n, n));
     if(vType == VectorType::RowMatrix)
         return m;
     if(vType == VectorType::ColumnMatrix)
@@ -78,76 +168,53 @@ Matrix Vector::getMatrix(VectorType vType) const {
 
 // Operators
 
-std::ostream& operator<<(std::ostream& os, const Vector& vec) {
-    os << "( ";
-    for(std::size_t i = 0; i < vec.n; i++) {
-        os << vec.comps.at(i);
-        if(i != vec.n-1)
-            os << ", ";
-    }
-    os << " )\n";
-    return os;
+// Dot Product
+template<typename T>
+Accumulator<T> BasicVector<T>::dot(const BasicVector& rhs) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorDot, 2 * n);
+    if(n != rhs.n)
+        throw std::invalid_argument("Dot product is defined only for two same dimensional vectors!");
+
+    return dotProduct(comps.data(), rhs.comps.data(), n);
 }
 
-// Dot Product
-double operator*(const Vector& lhs, const Vector& rhs) {
-    if(lhs.n != rhs.n)
+// Partial dot products of chunks, summed in chunk order (see Execution.hpp)
+template<typename T>
+Accumulator<T> BasicVector<T>::dot(ExecutionPolicy policy, const BasicVector& rhs) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorDot, 2 * n);
+    if(n != rhs.n)
         throw std::invalid_argument("Dot product is defined only for two same dimensional vectors!");
 
-    return std::inner_product(lhs.comps.begin(), lhs.comps.end(), rhs.comps.begin(), 0.0);
+    return reduceChunks<Accumulator<T>>(policy, n, [&](std::size_t begin, std::size_t end) {
+        return dotProduct(comps.data() + begin, rhs.comps.data() + begin, end - begin);
+    });
 }
 
 // Cross Product
-Vector operator^(const Vector& lhs, const Vector& rhs) {
-    if( lhs.n != 3 || rhs.n != 3)
+template<typename T>
+BasicVector<T> BasicVector<T>::cross(const BasicVector& rhs) const {
+    LINEAROBJECTS_INSTRUMENT(InstrumentedOperation::VectorCross, 9);
+    if( n != 3 || rhs.n != 3)
         throw std::invalid_argument("Cross Product is only defined for two 3 dimensional vectors!");
 
-    Vector result = {
-            lhs.comps.at(1) * rhs.comps.at(2) - rhs.comps.at(1) * lhs.comps.at(2),
-            rhs.comps.at(0) * lhs.comps.at(2) - lhs.comps.at(0) * rhs.comps.at(2),
-            lhs.comps.at(0) * rhs.comps.at(1) - rhs.comps.at(0) * lhs.comps.at(1)
+    BasicVector result = {
+            comps.at(1) * rhs.comps.at(2) - rhs.comps.at(1) * comps.at(2),
+            rhs.comps.at(0) * comps.at(2) - comps.at(0) * rhs.comps.at(2),
+            comps.at(0) * rhs.comps.at(1) - rhs.comps.at(0) * comps.at(1)
     };
     return result;
 }
 
-Vector operator*(const Vector& vec, double coeff) {
-    return coeff*vec;
+template<typename T>
+BasicVector<T>::operator BasicVectorView<T>() {
+    return BasicVectorView<T>(comps.data(), n);
 }
 
-Vector operator*(double coeff, const Vector& vec) {
-    Vector result(vec.n);
-    std::transform(vec.comps.begin(), vec.comps.end(), result.comps.begin(),
-                   [coeff](double comp){ return comp * coeff;});
-    return result;
+template<typename T>
+BasicVector<T>::operator BasicVectorView<const T>() const {
+    return BasicVectorView<const T>(comps.data(), n);
 }
 
-Vector operator+(const Vector &lhs, const Vector &rhs) {
-    if(lhs.n != rhs.n)
-        throw std::invalid_argument("Vector addition is defined only for two same dimensional vectors!");
-    Vector result(lhs);
-
-    for(std::size_t i = 0; i < lhs.n; i++)
-        result[i] += rhs[i];
-
-    return result;
-}
-
-Vector Vector::operator-() const {
-    return (*this) * (-1);
-}
-
-Vector operator-(const Vector &lhs, const Vector &rhs){
-    return lhs + ( -rhs );
-}
-
-double& Vector::operator[](std::size_t i) {
-    if( i >= n )
-        throw std::invalid_argument("Index out of bound");
-    return comps.at(i);
-}
-
-const double& Vector::operator[](std::size_t i) const {
-    if( i >= n )
-        throw std::invalid_argument("Index out of bound");
-    return comps.at(i);
-}
+template class BasicVector<double>;
+template class BasicVector<float>;
+template class BasicVector<int>;
@@ -0,0 +1,308 @@
+#include "VectorBatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "ThreadPool.hpp"
+#include "VectorKernels.hpp"
+
+namespace {
+
+constexpr std::size_t LANE_ALIGNMENT = 8;           // Doubles per cache line
+constexpr std::size_t BLOCK = 1024;                 // Vectors per kernel call; the lanes touched stay in L1
+constexpr std::size_t VECTORS_PER_TASK = 64 * BLOCK;
+
+std::size_t laneStride(std::size_t count) {
+    return (count + LANE_ALIGNMENT - 1) / LANE_ALIGNMENT * LANE_ALIGNMENT;
+}
+
+// Calls body(first, length) over consecutive blocks of [0, count). Blocks are grouped into tasks for
+// the thread pool; every block is computed the same way whichever thread runs it.
+template<typename Body>
+void forEachBlock(std::size_t count, const Body& body) {
+    auto task = [&](std::size_t taskIdx) {
+        std::size_t end = std::min(count, (taskIdx + 1) * VECTORS_PER_TASK);
+        for(std::size_t first = taskIdx * VECTORS_PER_TASK; first < end; first += BLOCK)
+            body(first, std::min(BLOCK, end - first));
+    };
+    std::size_t taskCount = (count + VECTORS_PER_TASK - 1) / VECTORS_PER_TASK;
+    if(taskCount == 1)
+        task(0);
+    else
+        ThreadPool::instance().parallelFor(taskCount, task);
+}
+
+void checkResult(ConstVectorView result, std::size_t count) {
+    if(result.getDimension() != count)
+        throw std::invalid_argument("Vector should contain " + std::to_string(count) + " Elements");
+    if(result.getStride() != 1)
+        throw std::invalid_argument("Result view should be contiguous");
+}
+
+}
+
+// Constructors
+
+VectorBatch::VectorBatch(std::size_t vectorDimension, std::size_t vectorCount)
+    : data(), dimension(vectorDimension), count(vectorCount), stride(laneStride(vectorCount)) {
+    if(dimension == 0 || count == 0)
+        throw std::invalid_argument("Condition didn't match (dimension, count > 0)");
+    data.resize(dimension * stride);
+}
+
+VectorBatch::VectorBatch(const std::vector<Vector>& vectors)
+    : VectorBatch(vectors.empty() ? 0 : vectors[0].getDimension(), vectors.size()) {
+    for(std::size_t i = 0; i < count; i++) {
+        if(vectors[i].getDimension() != dimension)
+            throw std::invalid_argument("Every vector should contain same amount of elements!");
+        for(std::size_t c = 0; c < dimension; c++)
+            lane(c)[i] = vectors[i].element(c);
+    }
+}
+
+// Compound Assignment
+
+VectorBatch& VectorBatch::operator+=(const VectorBatch& rhs) {
+    if(rhs.dimension != dimension || rhs.count != count)
+        throw std::invalid_argument("Vector addition is defined only for two same dimensional vectors!");
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        for(std::size_t c = 0; c < dimension; c++)
+            kernels.add(lane(c) + first, rhs.lane(c) + first, lane(c) + first, length);
+    });
+    return *this;
+}
+
+VectorBatch& VectorBatch::operator-=(const VectorBatch& rhs) {
+    if(rhs.dimension != dimension || rhs.count != count)
+        throw std::invalid_argument("Vector subtraction is defined only for two same dimensional vectors!");
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        for(std::size_t c = 0; c < dimension; c++)
+            kernels.axpy(-1.0, rhs.lane(c) + first, lane(c) + first, length);
+    });
+    return *this;
+}
+
+VectorBatch& VectorBatch::operator*=(double coeff) {
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        for(std::size_t c = 0; c < dimension; c++)
+            kernels.scale(lane(c) + first, coeff, lane(c) + first, length);
+    });
+    return *this;
+}
+
+// Methods
+
+Vector VectorBatch::dot(const VectorBatch& rhs) const {
+    Vector result(count);
+    dot(rhs, result);
+    return result;
+}
+
+void VectorBatch::dot(const VectorBatch& rhs, VectorView result) const {
+    if(rhs.dimension != dimension || rhs.count != count)
+        throw std::invalid_argument("Dot product is defined only for two same dimensional vectors!");
+    checkResult(result, count);
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        double* out = result.data() + first;
+        kernels.multiply(lane(0) + first, rhs.lane(0) + first, out, length);
+        for(std::size_t c = 1; c < dimension; c++)
+            kernels.multiplyAdd(1.0, lane(c) + first, rhs.lane(c) + first, out, length);
+    });
+}
+
+Vector VectorBatch::magnitude() const {
+    Vector result(count);
+    magnitude(result);
+    return result;
+}
+
+void VectorBatch::magnitude(VectorView result) const {
+    checkResult(result, count);
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        double* out = result.data() + first;
+        kernels.multiply(lane(0) + first, lane(0) + first, out, length);
+        for(std::size_t c = 1; c < dimension; c++)
+            kernels.multiplyAdd(1.0, lane(c) + first, lane(c) + first, out, length);
+        kernels.squareRoot(out, out, length);
+    });
+}
+
+Vector VectorBatch::angle(const VectorBatch& rhs) const {
+    Vector result(count);
+    angle(rhs, result);
+    return result;
+}
+
+void VectorBatch::angle(const VectorBatch& rhs, VectorView result) const {
+    if(rhs.dimension != dimension || rhs.count != count)
+        throw std::invalid_argument("Angle is defined only for two same dimensional vectors!");
+    checkResult(result, count);
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        double lhsNorm[BLOCK];
+        double rhsNorm[BLOCK];
+        double* out = result.data() + first;
+        kernels.multiply(lane(0) + first, rhs.lane(0) + first, out, length);
+        kernels.multiply(lane(0) + first, lane(0) + first, lhsNorm, length);
+        kernels.multiply(rhs.lane(0) + first, rhs.lane(0) + first, rhsNorm, length);
+        for(std::size_t c = 1; c < dimension; c++) {
+            kernels.multiplyAdd(1.0, lane(c) + first, rhs.lane(c) + first, out, length);
+            kernels.multiplyAdd(1.0, lane(c) + first, lane(c) + first, lhsNorm, length);
+            kernels.multiplyAdd(1.0, rhs.lane(c) + first, rhs.lane(c) + first, rhsNorm, length);
+        }
+        kernels.squareRoot(lhsNorm, lhsNorm, length);
+        kernels.squareRoot(rhsNorm, rhsNorm, length);
+        kernels.multiply(lhsNorm, rhsNorm, lhsNorm, length);
+        for(std::size_t i = 0; i < length; i++)
+            out[i] = std::acos(out[i] / lhsNorm[i]);
+    });
+}
+
+VectorBatch VectorBatch::cross(const VectorBatch& rhs) const {
+    VectorBatch result(3, count);
+    cross(rhs, result);
+    return result;
+}
+
+void VectorBatch::cross(const VectorBatch& rhs, VectorBatch& result) const {
+    if(dimension != 3 || rhs.dimension != 3)
+        throw std::invalid_argument("Cross Product is only defined for two 3 dimensional vectors!");
+    if(rhs.count != count)
+        throw std::invalid_argument("Batches should contain the same number of vectors!");
+    if(&result == this || &result == &rhs) {
+        VectorBatch product(3, count);
+        cross(rhs, product);
+        result = std::move(product);
+        return;
+    }
+    if(result.dimension != 3 || result.count != count)
+        result = VectorBatch(3, count);
+
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        for(std::size_t c = 0; c < 3; c++) {
+            std::size_t next = (c + 1) % 3, last = (c + 2) % 3;
+            double* out = result.lane(c) + first;
+            kernels.multiply(lane(next) + first, rhs.lane(last) + first, out, length);
+            kernels.multiplyAdd(-1.0, lane(last) + first, rhs.lane(next) + first, out, length);
+        }
+    });
+}
+
+VectorBatch VectorBatch::transform(ConstMatrixView matrix) const {
+    VectorBatch result(matrix.getDimension().rowCount, count);
+    transform(matrix, result);
+    return result;
+}
+
+void VectorBatch::transform(ConstMatrixView matrix, VectorBatch& result) const {
+    const MatrixSize& matrixSize = matrix.getDimension();
+    if(matrixSize.columnCount != dimension)
+        throw std::invalid_argument("Matrix's column count should be equal to the vectors' dimension!");
+    if(&result == this) {
+        VectorBatch product(matrixSize.rowCount, count);
+        transform(matrix, product);
+        result = std::move(product);
+        return;
+    }
+    if(result.dimension != matrixSize.rowCount || result.count != count)
+        result = VectorBatch(matrixSize.rowCount, count);
+
+    // Row r of the result is the combination of the input lanes weighted by row r of the matrix.
+    const VectorKernels& kernels = activeVectorKernels();
+    forEachBlock(count, [&](std::size_t first, std::size_t length) {
+        for(std::size_t r = 0; r < matrixSize.rowCount; r++) {
+            double* out = result.lane(r) + first;
+            kernels.scale(lane(0) + first, matrix.element(r, 0), out, length);
+            for(std::size_t c = 1; c < dimension; c++)
+                kernels.axpy(matrix.element(r, c), lane(c) + first, out, length);
+        }
+    });
+}
+
+std::vector<Vector> VectorBatch::toVectors() const {
+    std::vector<Vector> vectors;
+    vectors.reserve(count);
+    for(std::size_t i = 0; i < count; i++)
+        vectors.push_back(getVector(i));
+    return vectors;
+}
+
+// Getters
+
+std::size_t VectorBatch::getDimension() const {
+    return dimension;
+}
+
+std::size_t VectorBatch::getCount() const {
+    return count;
+}
+
+Vector VectorBatch::getVector(std::size_t idx) const {
+    if(idx >= count)
+        throw std::invalid_argument("Index out of bound");
+    return Vector(ConstVectorView(data.data() + idx, dimension, stride));
+}
+
+VectorView VectorBatch::component(std::size_t idx) {
+    if(idx >= dimension)
+        throw std::invalid_argument("Index out of bound");
+    return VectorView(lane(idx), count);
+}
+
+ConstVectorView VectorBatch::component(std::size_t idx) const {
+    if(idx >= dimension)
+        throw std::invalid_argument("Index out of bound");
+    return ConstVectorView(lane(idx), count);
+}
+
+// Setters
+
+VectorBatch& VectorBatch::setVector(std::size_t idx, const Vector& vec) {
+    if(vec.getDimension() != dimension)
+        throw std::invalid_argument("Vector should contain " + std::to_string(dimension) + " Elements");
+    if(idx >= count)
+        throw std::invalid_argument("Index out of bound");
+    VectorView(data.data() + idx, dimension, stride) = vec;
+    return *this;
+}
+
+// Friend Operators
+
+VectorBatch operator+(const VectorBatch& lhs, const VectorBatch& rhs) {
+    VectorBatch result(lhs);
+    result += rhs;
+    return result;
+}
+
+VectorBatch operator-(const VectorBatch& lhs, const VectorBatch& rhs) {
+    VectorBatch result(lhs);
+    result -= rhs;
+    return result;
+}
+
+VectorBatch operator*(double coeff, const VectorBatch& batch) {
+    VectorBatch result(batch);
+    result *= coeff;
+    return result;
+}
+
+VectorBatch operator*(const VectorBatch& batch, double coeff) {
+    return coeff * batch;
+}
+
+VectorBatch operator^(const VectorBatch& lhs, const VectorBatch& rhs) {
+    return lhs.cross(rhs);
+}
+
+VectorBatch operator*(ConstMatrixView matrix, const VectorBatch& batch) {
+    return batch.transform(matrix);
+}
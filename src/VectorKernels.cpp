@@ -0,0 +1,475 @@
+#include "VectorKernels.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define LINEAROBJECTS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define LINEAROBJECTS_TARGET(isa)
+#else
+#define LINEAROBJECTS_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace {
+
+// Scalar reference implementation (four independent partial sums so the dot product is not latency bound).
+
+double dotScalar(const double* lhs, const double* rhs, std::size_t n) {
+    double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        sum0 += lhs[i] * rhs[i];
+        sum1 += lhs[i + 1] * rhs[i + 1];
+        sum2 += lhs[i + 2] * rhs[i + 2];
+        sum3 += lhs[i + 3] * rhs[i + 3];
+    }
+    for(; i < n; i++)
+        sum0 += lhs[i] * rhs[i];
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+double dotFloatScalar(const float* lhs, const float* rhs, std::size_t n) {
+    double sum0 = 0.0, sum1 = 0.0, sum2 = 0.0, sum3 = 0.0;
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        sum0 += static_cast<double>(lhs[i]) * rhs[i];
+        sum1 += static_cast<double>(lhs[i + 1]) * rhs[i + 1];
+        sum2 += static_cast<double>(lhs[i + 2]) * rhs[i + 2];
+        sum3 += static_cast<double>(lhs[i + 3]) * rhs[i + 3];
+    }
+    for(; i < n; i++)
+        sum0 += static_cast<double>(lhs[i]) * rhs[i];
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
+void addScalar(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        out[i] = lhs[i] + rhs[i];
+}
+
+void scaleScalar(const double* vec, double coeff, double* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        out[i] = coeff * vec[i];
+}
+
+void axpyScalar(double coeff, const double* vec, double* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        out[i] += coeff * vec[i];
+}
+
+void multiplyScalar(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        out[i] = lhs[i] * rhs[i];
+}
+
+void multiplyAddScalar(double coeff, const double* lhs, const double* rhs, double* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        out[i] += coeff * lhs[i] * rhs[i];
+}
+
+void squareRootScalar(const double* vec, double* out, std::size_t n) {
+    for(std::size_t i = 0; i < n; i++)
+        out[i] = std::sqrt(vec[i]);
+}
+
+constexpr VectorKernels scalarKernels{"scalar", dotScalar, dotFloatScalar, addScalar, scaleScalar, axpyScalar,
+                                      multiplyScalar, multiplyAddScalar, squareRootScalar};
+
+#ifdef LINEAROBJECTS_X86
+
+// SSE2 (baseline on x86-64)
+
+LINEAROBJECTS_TARGET("sse2")
+double dotSse2(const double* lhs, const double* rhs, std::size_t n) {
+    __m128d sum0 = _mm_setzero_pd(), sum1 = _mm_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_loadu_pd(lhs + i + 2), _mm_loadu_pd(rhs + i + 2)));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(sum0, sum1));
+    double sum = lanes[0] + lanes[1];
+    for(; i < n; i++)
+        sum += lhs[i] * rhs[i];
+    return sum;
+}
+
+LINEAROBJECTS_TARGET("sse2")
+double dotFloatSse2(const float* lhs, const float* rhs, std::size_t n) {
+    __m128d sum0 = _mm_setzero_pd(), sum1 = _mm_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m128 x = _mm_loadu_ps(lhs + i), y = _mm_loadu_ps(rhs + i);
+        sum0 = _mm_add_pd(sum0, _mm_mul_pd(_mm_cvtps_pd(x), _mm_cvtps_pd(y)));
+        sum1 = _mm_add_pd(sum1, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), _mm_cvtps_pd(_mm_movehl_ps(y, y))));
+    }
+    double lanes[2];
+    _mm_storeu_pd(lanes, _mm_add_pd(sum0, sum1));
+    double sum = lanes[0] + lanes[1];
+    for(; i < n; i++)
+        sum += static_cast<double>(lhs[i]) * rhs[i];
+    return sum;
+}
+
+LINEAROBJECTS_TARGET("sse2")
+void addSse2(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    for(; i < n; i++)
+        out[i] = lhs[i] + rhs[i];
+}
+
+LINEAROBJECTS_TARGET("sse2")
+void scaleSse2(const double* vec, double coeff, double* out, std::size_t n) {
+    __m128d factor = _mm_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_mul_pd(factor, _mm_loadu_pd(vec + i)));
+    for(; i < n; i++)
+        out[i] = coeff * vec[i];
+}
+
+LINEAROBJECTS_TARGET("sse2")
+void axpySse2(double coeff, const double* vec, double* out, std::size_t n) {
+    __m128d factor = _mm_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(out + i), _mm_mul_pd(factor, _mm_loadu_pd(vec + i))));
+    for(; i < n; i++)
+        out[i] += coeff * vec[i];
+}
+
+LINEAROBJECTS_TARGET("sse2")
+void multiplySse2(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    for(; i < n; i++)
+        out[i] = lhs[i] * rhs[i];
+}
+
+LINEAROBJECTS_TARGET("sse2")
+void multiplyAddSse2(double coeff, const double* lhs, const double* rhs, double* out, std::size_t n) {
+    __m128d factor = _mm_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2) {
+        __m128d product = _mm_mul_pd(factor, _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(out + i), product));
+    }
+    for(; i < n; i++)
+        out[i] += coeff * lhs[i] * rhs[i];
+}
+
+LINEAROBJECTS_TARGET("sse2")
+void squareRootSse2(const double* vec, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2)
+        _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(vec + i)));
+    for(; i < n; i++)
+        out[i] = std::sqrt(vec[i]);
+}
+
+constexpr VectorKernels sse2Kernels{"sse2", dotSse2, dotFloatSse2, addSse2, scaleSse2, axpySse2,
+                                    multiplySse2, multiplyAddSse2, squareRootSse2};
+
+// AVX2 + FMA
+
+LINEAROBJECTS_TARGET("avx2,fma")
+double dotAvx2(const double* lhs, const double* rhs, std::size_t n) {
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+    __m256d sum2 = _mm256_setzero_pd(), sum3 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i), sum0);
+        sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i + 4), _mm256_loadu_pd(rhs + i + 4), sum1);
+        sum2 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i + 8), _mm256_loadu_pd(rhs + i + 8), sum2);
+        sum3 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i + 12), _mm256_loadu_pd(rhs + i + 12), sum3);
+    }
+    for(; i + 4 <= n; i += 4)
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i), sum0);
+    __m256d sum = _mm256_add_pd(_mm256_add_pd(sum0, sum1), _mm256_add_pd(sum2, sum3));
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    double result = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for(; i < n; i++)
+        result += lhs[i] * rhs[i];
+    return result;
+}
+
+LINEAROBJECTS_TARGET("avx2,fma")
+double dotFloatAvx2(const float* lhs, const float* rhs, std::size_t n) {
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        sum0 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(lhs + i)), _mm256_cvtps_pd(_mm_loadu_ps(rhs + i)), sum0);
+        sum1 = _mm256_fmadd_pd(_mm256_cvtps_pd(_mm_loadu_ps(lhs + i + 4)), _mm256_cvtps_pd(_mm_loadu_ps(rhs + i + 4)), sum1);
+    }
+    __m256d sum = _mm256_add_pd(sum0, sum1);
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    double result = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for(; i < n; i++)
+        result += static_cast<double>(lhs[i]) * rhs[i];
+    return result;
+}
+
+LINEAROBJECTS_TARGET("avx2,fma")
+void addAvx2(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    for(; i < n; i++)
+        out[i] = lhs[i] + rhs[i];
+}
+
+LINEAROBJECTS_TARGET("avx2,fma")
+void scaleAvx2(const double* vec, double coeff, double* out, std::size_t n) {
+    __m256d factor = _mm256_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(factor, _mm256_loadu_pd(vec + i)));
+    for(; i < n; i++)
+        out[i] = coeff * vec[i];
+}
+
+LINEAROBJECTS_TARGET("avx2,fma")
+void axpyAvx2(double coeff, const double* vec, double* out, std::size_t n) {
+    __m256d factor = _mm256_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_fmadd_pd(factor, _mm256_loadu_pd(vec + i), _mm256_loadu_pd(out + i)));
+    for(; i < n; i++)
+        out[i] += coeff * vec[i];
+}
+
+LINEAROBJECTS_TARGET("avx2,fma")
+void multiplyAvx2(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    for(; i < n; i++)
+        out[i] = lhs[i] * rhs[i];
+}
+
+LINEAROBJECTS_TARGET("avx2,fma")
+void multiplyAddAvx2(double coeff, const double* lhs, const double* rhs, double* out, std::size_t n) {
+    __m256d factor = _mm256_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4) {
+        __m256d scaled = _mm256_mul_pd(factor, _mm256_loadu_pd(lhs + i));
+        _mm256_storeu_pd(out + i, _mm256_fmadd_pd(scaled, _mm256_loadu_pd(rhs + i), _mm256_loadu_pd(out + i)));
+    }
+    for(; i < n; i++)
+        out[i] += coeff * lhs[i] * rhs[i];
+}
+
+LINEAROBJECTS_TARGET("avx2,fma")
+void squareRootAvx2(const double* vec, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4)
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(vec + i)));
+    for(; i < n; i++)
+        out[i] = std::sqrt(vec[i]);
+}
+
+constexpr VectorKernels avx2Kernels{"avx2", dotAvx2, dotFloatAvx2, addAvx2, scaleAvx2, axpyAvx2,
+                                    multiplyAvx2, multiplyAddAvx2, squareRootAvx2};
+
+// AVX-512F (tails handled with masked loads/stores)
+
+LINEAROBJECTS_TARGET("avx512f")
+double dotAvx512(const double* lhs, const double* rhs, std::size_t n) {
+    __m512d sum0 = _mm512_setzero_pd(), sum1 = _mm512_setzero_pd();
+    __m512d sum2 = _mm512_setzero_pd(), sum3 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 32 <= n; i += 32) {
+        sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i), sum0);
+        sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(lhs + i + 8), _mm512_loadu_pd(rhs + i + 8), sum1);
+        sum2 = _mm512_fmadd_pd(_mm512_loadu_pd(lhs + i + 16), _mm512_loadu_pd(rhs + i + 16), sum2);
+        sum3 = _mm512_fmadd_pd(_mm512_loadu_pd(lhs + i + 24), _mm512_loadu_pd(rhs + i + 24), sum3);
+    }
+    for(; i + 8 <= n; i += 8)
+        sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i), sum0);
+    if(i < n) {
+        auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        sum1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, lhs + i), _mm512_maskz_loadu_pd(mask, rhs + i), sum1);
+    }
+    double lanes[8];
+    _mm512_storeu_pd(lanes, _mm512_add_pd(_mm512_add_pd(sum0, sum1), _mm512_add_pd(sum2, sum3)));
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+}
+
+LINEAROBJECTS_TARGET("avx512f")
+double dotFloatAvx512(const float* lhs, const float* rhs, std::size_t n) {
+    __m512d sum0 = _mm512_setzero_pd(), sum1 = _mm512_setzero_pd();
+    std::size_t i = 0;
+    for(; i + 16 <= n; i += 16) {
+        // (maskz: GCC 12 warns about the undefined source of the unmasked conversion)
+        sum0 = _mm512_fmadd_pd(_mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(lhs + i)),
+                               _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(rhs + i)), sum0);
+        sum1 = _mm512_fmadd_pd(_mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(lhs + i + 8)),
+                               _mm512_maskz_cvtps_pd(0xFF, _mm256_loadu_ps(rhs + i + 8)), sum1);
+    }
+    double lanes[8];
+    _mm512_storeu_pd(lanes, _mm512_add_pd(sum0, sum1));
+    double result = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+    for(; i < n; i++)
+        result += static_cast<double>(lhs[i]) * rhs[i];
+    return result;
+}
+
+LINEAROBJECTS_TARGET("avx512f")
+void addAvx512(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+    if(i < n) {
+        auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(out + i, mask,
+                              _mm512_add_pd(_mm512_maskz_loadu_pd(mask, lhs + i), _mm512_maskz_loadu_pd(mask, rhs + i)));
+    }
+}
+
+LINEAROBJECTS_TARGET("avx512f")
+void scaleAvx512(const double* vec, double coeff, double* out, std::size_t n) {
+    __m512d factor = _mm512_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(factor, _mm512_loadu_pd(vec + i)));
+    if(i < n) {
+        auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(out + i, mask, _mm512_mul_pd(factor, _mm512_maskz_loadu_pd(mask, vec + i)));
+    }
+}
+
+LINEAROBJECTS_TARGET("avx512f")
+void axpyAvx512(double coeff, const double* vec, double* out, std::size_t n) {
+    __m512d factor = _mm512_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_fmadd_pd(factor, _mm512_loadu_pd(vec + i), _mm512_loadu_pd(out + i)));
+    if(i < n) {
+        auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(out + i, mask, _mm512_fmadd_pd(factor, _mm512_maskz_loadu_pd(mask, vec + i),
+                                                             _mm512_maskz_loadu_pd(mask, out + i)));
+    }
+}
+
+LINEAROBJECTS_TARGET("avx512f")
+void multiplyAvx512(const double* lhs, const double* rhs, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_mul_pd(_mm512_loadu_pd(lhs + i), _mm512_loadu_pd(rhs + i)));
+    if(i < n) {
+        auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(out + i, mask,
+                              _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, lhs + i), _mm512_maskz_loadu_pd(mask, rhs + i)));
+    }
+}
+
+LINEAROBJECTS_TARGET("avx512f")
+void multiplyAddAvx512(double coeff, const double* lhs, const double* rhs, double* out, std::size_t n) {
+    __m512d factor = _mm512_set1_pd(coeff);
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8) {
+        __m512d scaled = _mm512_mul_pd(factor, _mm512_loadu_pd(lhs + i));
+        _mm512_storeu_pd(out + i, _mm512_fmadd_pd(scaled, _mm512_loadu_pd(rhs + i), _mm512_loadu_pd(out + i)));
+    }
+    if(i < n) {
+        auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        __m512d scaled = _mm512_mul_pd(factor, _mm512_maskz_loadu_pd(mask, lhs + i));
+        _mm512_mask_storeu_pd(out + i, mask, _mm512_fmadd_pd(scaled, _mm512_maskz_loadu_pd(mask, rhs + i),
+                                                             _mm512_maskz_loadu_pd(mask, out + i)));
+    }
+}
+
+// The zero-masked form of sqrt: GCC 12 flags the undefined pass-through operand of _mm512_sqrt_pd.
+LINEAROBJECTS_TARGET("avx512f")
+void squareRootAvx512(const double* vec, double* out, std::size_t n) {
+    std::size_t i = 0;
+    for(; i + 8 <= n; i += 8)
+        _mm512_storeu_pd(out + i, _mm512_maskz_sqrt_pd(0xFF, _mm512_loadu_pd(vec + i)));
+    if(i < n) {
+        auto mask = static_cast<__mmask8>((1u << (n - i)) - 1u);
+        _mm512_mask_storeu_pd(out + i, mask, _mm512_maskz_sqrt_pd(mask, _mm512_maskz_loadu_pd(mask, vec + i)));
+    }
+}
+
+constexpr VectorKernels avx512Kernels{"avx512", dotAvx512, dotFloatAvx512, addAvx512, scaleAvx512, axpyAvx512,
+                                      multiplyAvx512, multiplyAddAvx512, squareRootAvx512};
+
+enum class Isa { Scalar, Sse2, Avx2, Avx512 };
+
+Isa detectIsa() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4]{};
+    __cpuid(info, 0);
+    if(info[0] < 7)
+        return Isa::Sse2;
+    __cpuid(info, 1);
+    bool osAvx = (info[2] & (1 << 27)) && (info[2] & (1 << 28));
+    bool fma = info[2] & (1 << 12);
+    if(!osAvx)
+        return Isa::Sse2;
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex(info, 7, 0);
+    if((xcr0 & 0xE6) == 0xE6 && (info[1] & (1 << 16)))
+        return Isa::Avx512;
+    if((xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) && fma)
+        return Isa::Avx2;
+    return Isa::Sse2;
+#else
+    // __builtin_cpu_supports also checks that the OS saves the wider register state.
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx512f"))
+        return Isa::Avx512;
+    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        return Isa::Avx2;
+    if(__builtin_cpu_supports("sse2"))
+        return Isa::Sse2;
+    return Isa::Scalar;
+#endif
+}
+
+#endif
+
+const VectorKernels& selectKernels() {
+#ifdef LINEAROBJECTS_X86
+    Isa isa = detectIsa();
+    if(const char* requested = std::getenv("LINEAROBJECTS_SIMD")) {
+        Isa cap = Isa::Avx512;
+        if(std::strcmp(requested, "scalar") == 0)
+            cap = Isa::Scalar;
+        else if(std::strcmp(requested, "sse2") == 0)
+            cap = Isa::Sse2;
+        else if(std::strcmp(requested, "avx2") == 0)
+            cap = Isa::Avx2;
+        if(cap < isa)
+            isa = cap;
+    }
+
+    switch(isa) {
+        case Isa::Avx512: return avx512Kernels;
+        case Isa::Avx2: return avx2Kernels;
+        case Isa::Sse2: return sse2Kernels;
+        case Isa::Scalar: break;
+    }
+#endif
+    return scalarKernels;
+}
+
+}
+
+const VectorKernels& activeVectorKernels() {
+    static const VectorKernels& kernels = selectKernels();
+    return kernels;
+}
+
+const VectorKernels& scalarVectorKernels() {
+    return scalarKernels;
+}